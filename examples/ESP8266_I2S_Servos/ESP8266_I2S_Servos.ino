@@ -0,0 +1,77 @@
+/****************************************************************************************************************************
+  ESP8266_I2S_Servos.ino
+  For ESP8266 boards
+  Written by Khoi Hoang
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP8266_ISR_Servo
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+/****************************************************************************************************************************
+   This example drives up to 16 servos without any timer interrupt. The frame is streamed by DMA through I2S
+   into 2 chained 74HC595 shift registers, and the CPU is only used when a servo position changes.
+
+   Circuit:
+   I2S data        GPIO3  (RX) => SER   of the first 74HC595, QH' to SER of the second one
+   I2S bit clock   GPIO15 (D8) => SRCLK of both 74HC595
+   I2S word select GPIO2  (D4) => RCLK  of both 74HC595
+   Servo n signal wire to the output n of the shift registers (QA-QH of the first one, then of the second one)
+
+   Serial RX is used for I2S data, so Serial is only used for output.
+*****************************************************************************************************************************/
+
+#ifndef ESP8266
+  #error This code is designed to run on ESP8266 platform! Please check your Tools->Board setting.
+#endif
+
+#define ISR_SERVO_DEBUG             1
+
+// To be included only in main(), .ino with setup() to avoid `Multiple Definitions` Linker Error
+#include "ESP8266_I2S_Servo.h"
+
+// Published values for SG90 servos; adjust if needed
+#define MIN_MICROS      800  //544
+#define MAX_MICROS      2450
+
+#define NUM_SERVOS      4
+
+int servoIndex[NUM_SERVOS];
+
+void setup()
+{
+  Serial.begin(115200, SERIAL_8N1, SERIAL_TX_ONLY);
+
+  while (!Serial);
+
+  delay(200);
+
+  Serial.print(F("\nStarting ESP8266_I2S_Servos on "));
+  Serial.println(ARDUINO_BOARD);
+  Serial.println(ESP8266_ISR_SERVO_VERSION);
+
+  for (int index = 0; index < NUM_SERVOS; index++)
+  {
+    servoIndex[index] = I2S_Servo.setupServo(index, MIN_MICROS, MAX_MICROS);
+
+    if (servoIndex[index] != -1)
+      Serial.println(F("Setup Servo OK"));
+    else
+      Serial.println(F("Setup Servo failed"));
+  }
+}
+
+void loop()
+{
+  for (int position = 0; position <= 180; position++)
+  {
+    for (int index = 0; index < NUM_SERVOS; index++)
+    {
+      I2S_Servo.setPosition(servoIndex[index], (position + index * (180 / NUM_SERVOS)) % 180 );
+    }
+
+    // waits for the servos to reach the position
+    delay(50);
+  }
+
+  delay(5000);
+}
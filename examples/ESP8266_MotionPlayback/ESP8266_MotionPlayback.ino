@@ -0,0 +1,87 @@
+/****************************************************************************************************************************
+  ESP8266_MotionPlayback.ino
+  For ESP8266 boards
+  Written by Khoi Hoang
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP8266_ISR_Servo
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+/****************************************************************************************************************************
+   This example plays a motion file from LittleFS, one frame every 20ms, streamed in small chunks so that
+   choreographies much longer than the RAM can be played.
+
+   Create the motion file from a CSV (one line per frame, one pulse width in microsecs per servo) with
+     utils/motion_encoder.py motion.csv motion.ism
+   then upload it as /motion.ism to LittleFS.
+*****************************************************************************************************************************/
+
+#ifndef ESP8266
+  #error This code is designed to run on ESP8266 platform! Please check your Tools->Board setting.
+#endif
+
+#define ISR_SERVO_DEBUG             1
+
+#include <LittleFS.h>
+
+// To be included only in main(), .ino with setup() to avoid `Multiple Definitions` Linker Error
+#include "ESP8266_ISR_Servo.h"
+#include "ESP8266_ISR_Servo_Motion.h"
+
+// Published values for SG90 servos; adjust if needed
+#define MIN_MICROS      800  //544
+#define MAX_MICROS      2450
+
+#define NUM_SERVOS      6
+
+const uint8_t servoPin[NUM_SERVOS] = { D1, D2, D3, D4, D5, D6 };
+
+int8_t servoIndex[NUM_SERVOS];
+
+ESP8266_ISR_Servo_Motion player(ISR_Servo, servoIndex, NUM_SERVOS);
+
+File motionFile;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  while (!Serial);
+
+  delay(200);
+
+  Serial.print(F("\nStarting ESP8266_MotionPlayback on "));
+  Serial.println(ARDUINO_BOARD);
+  Serial.println(ESP8266_ISR_SERVO_VERSION);
+
+  for (int index = 0; index < NUM_SERVOS; index++)
+  {
+    servoIndex[index] = ISR_Servo.setupServo(servoPin[index], MIN_MICROS, MAX_MICROS);
+  }
+
+  if (!LittleFS.begin())
+  {
+    Serial.println(F("LittleFS mount failed"));
+    return;
+  }
+
+  motionFile = LittleFS.open("/motion.ism", "r");
+
+  if (!motionFile || !player.begin(motionFile))
+    Serial.println(F("Can't play /motion.ism"));
+}
+
+void loop()
+{
+  if (player.isPlaying() && !player.update())
+  {
+    Serial.print(F("Done, frames = "));
+    Serial.print(player.getFramesPlayed());
+    Serial.print(F(", skipped = "));
+    Serial.print(player.getSkippedFrames());
+    Serial.print(F(", refused = "));
+    Serial.println(player.getPublishErrors());
+
+    motionFile.close();
+  }
+}
@@ -0,0 +1,95 @@
+/****************************************************************************************************************************
+  ESP8266_OscillatorGait.ino
+  For ESP8266 boards
+  Written by Khoi Hoang
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP8266_ISR_Servo
+  Licensed under MIT license
+ *****************************************************************************************************************************/
+
+/****************************************************************************************************************************
+   This example drives the 4 legs of a quadruped with a trot gait, generated by the oscillators of ESP8266_ISR_Servo.
+   The sine waves are evaluated in the ISR at each frame, so loop() only changes the speed every few seconds,
+   and the legs keep moving smoothly even when loop() is blocked.
+*****************************************************************************************************************************/
+
+#ifndef ESP8266
+  #error This code is designed to run on ESP8266 platform! Please check your Tools->Board setting.
+#endif
+
+#define ISR_SERVO_DEBUG             1
+
+// To be included only in main(), .ino with setup() to avoid `Multiple Definitions` Linker Error
+#include "ESP8266_ISR_Servo.h"
+
+// Published values for SG90 servos; adjust if needed
+#define MIN_MICROS      800  //544
+#define MAX_MICROS      2450
+
+#define CENTER_MICROS   1600
+#define STRIDE_MICROS   300
+
+#define NUM_LEGS        4
+
+const uint8_t legPin[NUM_LEGS] = { D1, D2, D3, D4 };
+
+// Trot : diagonal legs move together, half a period apart from the other pair
+const uint16_t legPhase[NUM_LEGS] = { 0, 180, 180, 0 };
+
+// Gait frequencies in milliHz
+const uint16_t gaitFrequency[] = { 500, 1000, 1500, 1000 };
+
+int8_t legIndex[NUM_LEGS];
+
+ESP8266_ISR_Servo_Group legs;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  while (!Serial);
+
+  delay(200);
+
+  Serial.print(F("\nStarting ESP8266_OscillatorGait on "));
+  Serial.println(ARDUINO_BOARD);
+  Serial.println(ESP8266_ISR_SERVO_VERSION);
+
+  for (int index = 0; index < NUM_LEGS; index++)
+  {
+    legIndex[index] = ISR_Servo.setupServo(legPin[index], MIN_MICROS, MAX_MICROS);
+
+    if (legIndex[index] != -1)
+    {
+      // Sub-microsec smooth motion. The oscillator ramps up from the current position by itself
+      ISR_Servo.setDithering(legIndex[index], true);
+
+      ISR_Servo.setOscillator(legIndex[index], CENTER_MICROS, STRIDE_MICROS, gaitFrequency[0], legPhase[index]);
+
+      legs.add(legIndex[index]);
+    }
+    else
+    {
+      Serial.print(F("Error setting up leg "));
+      Serial.println(index);
+    }
+  }
+
+  // Start all legs in the same frame
+  ISR_Servo.syncOscillators(legs);
+}
+
+void loop()
+{
+  static uint8_t speed = 0;
+
+  delay(5000);
+
+  speed = (speed + 1) % (sizeof(gaitFrequency) / sizeof(gaitFrequency[0]));
+
+  // All legs change speed in the same frame, keeping the gait
+  ISR_Servo.setOscillatorFrequency(legs, gaitFrequency[speed]);
+
+  Serial.print(F("Gait frequency (mHz) = "));
+  Serial.println(gaitFrequency[speed]);
+}
@@ -0,0 +1,29 @@
+/****************************************************************************************************************************
+  ESP8266_I2S_Servo.h
+  For ESP8266 boards
+  Written by Khoi Hoang
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP8266_ISR_Servo
+  Licensed under MIT license
+
+  Version: 1.3.0
+
+  Version Modified By   Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang      04/12/2019 Initial coding
+  1.0.1   K Hoang      05/12/2019 Add more features getPosition and getPulseWidth. Optimize.
+  1.0.2   K Hoang      20/12/2019 Add more Blynk examples.Change example names to avoid duplication.
+  1.1.0   K Hoang      03/01/2021 Fix bug. Add TOC and Version String.
+  1.2.0   K Hoang      18/05/2021 Update to match new ESP8266 core v3.0.0
+  1.3.0   K Hoang      28/02/2022 Convert to `h-only` style. Optimize code by using passing by `reference`
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef ESP8266_I2S_SERVO_H
+#define ESP8266_I2S_SERVO_H
+
+#include "ESP8266_I2S_Servo.hpp"
+#include "ESP8266_I2S_Servo_Impl.h"
+
+#endif
@@ -0,0 +1,163 @@
+/****************************************************************************************************************************
+  ESP8266_I2S_Servo.hpp
+  For ESP8266 boards
+  Written by Khoi Hoang
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP8266_ISR_Servo
+  Licensed under MIT license
+
+  Alternative to ESP8266_ISR_Servo, without any timer interrupt. Each frame (REFRESH_INTERVAL) is rendered once as a bit-stream
+  in RAM, then streamed forever by the SLC DMA through the I2S peripheral into 2 chained 74HC595 shift registers :
+  I2S data (GPIO3 / RX) => SER, I2S bit clock (GPIO15 / D8) => SRCLK, I2S word select (GPIO2 / D4) => RCLK.
+  The CPU is only used when setPosition() / setPulseWidth() re-render the samples between the old and new pulse ends.
+
+  Version: 1.3.0
+
+  Version Modified By   Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang      04/12/2019 Initial coding
+  1.0.1   K Hoang      05/12/2019 Add more features getPosition and getPulseWidth. Optimize.
+  1.0.2   K Hoang      20/12/2019 Add more Blynk examples.Change example names to avoid duplication.
+  1.1.0   K Hoang      03/01/2021 Fix bug. Add TOC and Version String.
+  1.2.0   K Hoang      18/05/2021 Update to match new ESP8266 core v3.0.0
+  1.3.0   K Hoang      28/02/2022 Convert to `h-only` style. Optimize code by using passing by `reference`
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef ESP8266_I2S_SERVO_HPP
+#define ESP8266_I2S_SERVO_HPP
+
+#ifndef ESP8266
+  #error This code is designed to run on ESP8266 platform! Please check your Tools->Board setting.
+#endif
+
+#if !defined(ESP8266_ISR_SERVO_VERSION)
+  #define ESP8266_ISR_SERVO_VERSION             "ESP8266_ISR_Servo v1.3.0"
+  
+  #define ESP8266_ISR_SERVO_VERSION_MAJOR       1
+  #define ESP8266_ISR_SERVO_VERSION_MINOR       3
+  #define ESP8266_ISR_SERVO_VERSION_PATCH       0
+
+  #define ESP8266_ISR_SERVO_VERSION_INT         1003000
+  
+#endif
+
+#if defined(ARDUINO)
+  #if ARDUINO >= 100
+    #include <Arduino.h>
+  #else
+    #include <WProgram.h>
+  #endif
+#endif
+
+#include "ESP8266_ISR_Servo_Debug.h"
+
+#include "ESP8266_I2S_Servo_Renderer.h"
+
+// From Servo.h - Copyright (c) 2009 Michael Margolis.  All right reserved.
+
+#define MIN_PULSE_WIDTH         544       // the shortest pulse sent to a servo  
+#define MAX_PULSE_WIDTH         2400      // the longest pulse sent to a servo 
+#define DEFAULT_PULSE_WIDTH     1500      // default pulse width when servo is attached
+#define REFRESH_INTERVAL        20000     // minumim time to refresh servos in microseconds 
+
+// Duration of one I2S sample in microsecs, from 1 to 63. Each frame uses (REFRESH_INTERVAL / resolution) * 4 bytes of RAM
+// With the default 10us, same as ESP8266_ISR_Servo, the frame buffer is 8000 bytes
+#ifndef ISR_SERVO_I2S_RESOLUTION_MICRO
+  #define ISR_SERVO_I2S_RESOLUTION_MICRO    10
+#endif
+
+#define ISR_SERVO_I2S_NUM_SAMPLES           (REFRESH_INTERVAL / ISR_SERVO_I2S_RESOLUTION_MICRO)
+
+// Samples per DMA descriptor, at most 1023 (4092 bytes)
+#define ISR_SERVO_I2S_SAMPLES_PER_DESC      500
+
+#define ISR_SERVO_I2S_NUM_DESC              ( (ISR_SERVO_I2S_NUM_SAMPLES + ISR_SERVO_I2S_SAMPLES_PER_DESC - 1) / ISR_SERVO_I2S_SAMPLES_PER_DESC )
+
+class ESP8266_I2S_Servo
+{
+  public:
+    // maximum number of servos, one per shift register output
+    const static uint8_t MAX_SERVOS = ESP8266_I2S_Servo_Renderer::MAX_CHANNELS;
+
+    // constructor
+    ESP8266_I2S_Servo();
+
+    // destructor
+    ~ESP8266_I2S_Servo()
+    {
+      stop();
+    }
+
+    // Bind servo to the shift register output channel (0-15), return servoIndex (= channel) or -1 on wrong channel
+    // The DMA is started by the first setupServo()
+    int8_t setupServo(const uint8_t& channel, const uint16_t& min = MIN_PULSE_WIDTH, const uint16_t& max = MAX_PULSE_WIDTH);
+
+    // setPosition will set servo to position in degrees
+    // returns true on success or false on wrong servoIndex
+    bool setPosition(const uint8_t& servoIndex, const uint16_t& position);
+
+    // returns last position in degrees if success, or -1 on wrong servoIndex
+    int getPosition(const uint8_t& servoIndex);
+
+    // setPulseWidth will set servo PWM Pulse Width in microseconds
+    // min and max for each individual servo are enforced
+    // returns true on success or false on wrong servoIndex
+    bool setPulseWidth(const uint8_t& servoIndex, uint16_t& pulseWidth);
+
+    // returns pulseWidth in microsecs (within min/max range) if success, or 0 on wrong servoIndex
+    unsigned int getPulseWidth(const uint8_t& servoIndex);
+
+    // destroy the specified servo, its output stays LOW
+    void deleteServo(const uint8_t& servoIndex);
+
+    // returns the number of used servos
+    int8_t getNumServos();
+
+    // stop the DMA and I2S
+    void stop();
+
+  private:
+
+    void init();
+
+    // render the pulse of servoIndex for pulseWidth in microsecs
+    void render(const uint8_t& servoIndex, const uint16_t& pulseWidth);
+
+    typedef struct
+    {
+      bool          attached;
+      uint16_t      position;             // In degrees
+      uint16_t      pulseWidth;           // In microsecs
+      uint16_t      min;
+      uint16_t      max;
+    } servo_t;
+
+    servo_t servo[MAX_SERVOS];
+
+    // actual number of servos in use (-1 means uninitialized)
+    int8_t numServos;
+
+    // SLC DMA descriptor, as expected by the hardware
+    typedef struct
+    {
+      uint32_t          blocksize : 12;
+      uint32_t          datalen   : 12;
+      uint32_t          unused    :  5;
+      uint32_t          sub_sof   :  1;
+      uint32_t          eof       :  1;
+      volatile uint32_t owner     :  1;
+      uint32_t*         buf_ptr;
+      void*             next_link_ptr;
+    } slc_desc_t;
+
+    // Circular list, the DMA loops over the frame forever
+    slc_desc_t  desc[ISR_SERVO_I2S_NUM_DESC];
+
+    uint32_t    frameBuffer[ISR_SERVO_I2S_NUM_SAMPLES];
+
+    ESP8266_I2S_Servo_Renderer renderer;
+};
+
+#endif    // ESP8266_I2S_SERVO_HPP
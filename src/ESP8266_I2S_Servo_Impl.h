@@ -0,0 +1,237 @@
+/****************************************************************************************************************************
+  ESP8266_I2S_Servo_Impl.h
+  For ESP8266 boards
+  Written by Khoi Hoang
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP8266_ISR_Servo
+  Licensed under MIT license
+
+  SLC DMA / I2S setup adapted from the ESP8266 Arduino core i2s.c
+
+  Version: 1.3.0
+
+  Version Modified By   Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang      04/12/2019 Initial coding
+  1.0.1   K Hoang      05/12/2019 Add more features getPosition and getPulseWidth. Optimize.
+  1.0.2   K Hoang      20/12/2019 Add more Blynk examples.Change example names to avoid duplication.
+  1.1.0   K Hoang      03/01/2021 Fix bug. Add TOC and Version String.
+  1.2.0   K Hoang      18/05/2021 Update to match new ESP8266 core v3.0.0
+  1.3.0   K Hoang      28/02/2022 Convert to `h-only` style. Optimize code by using passing by `reference`
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef ESP8266_I2S_SERVO_IMPL_H
+#define ESP8266_I2S_SERVO_IMPL_H
+
+#include <string.h>
+
+extern "C"
+{
+  #include "ets_sys.h"
+  #include "i2s_reg.h"
+}
+
+#ifndef ISR_SERVO_DEBUG
+  #define ISR_SERVO_DEBUG      1
+#endif
+
+#if ( (ISR_SERVO_I2S_RESOLUTION_MICRO < 1) || (ISR_SERVO_I2S_RESOLUTION_MICRO > 63) )
+  #error ISR_SERVO_I2S_RESOLUTION_MICRO must be from 1 to 63
+#endif
+
+static ESP8266_I2S_Servo I2S_Servo;  // create servo object to control up to 16 servos
+
+ESP8266_I2S_Servo::ESP8266_I2S_Servo()
+  : numServos (-1), renderer(frameBuffer, ISR_SERVO_I2S_NUM_SAMPLES)
+{
+}
+
+void ESP8266_I2S_Servo::init()
+{
+  memset(servo, 0, sizeof(servo));
+
+  renderer.clear();
+
+  for (uint8_t i = 0; i < ISR_SERVO_I2S_NUM_DESC; i++)
+  {
+    uint16_t numSamples = ISR_SERVO_I2S_NUM_SAMPLES - i * ISR_SERVO_I2S_SAMPLES_PER_DESC;
+
+    if (numSamples > ISR_SERVO_I2S_SAMPLES_PER_DESC)
+      numSamples = ISR_SERVO_I2S_SAMPLES_PER_DESC;
+
+    desc[i].owner         = 1;
+    desc[i].eof           = 1;
+    desc[i].sub_sof       = 0;
+    desc[i].unused        = 0;
+    desc[i].datalen       = numSamples * sizeof(uint32_t);
+    desc[i].blocksize     = numSamples * sizeof(uint32_t);
+    desc[i].buf_ptr       = &frameBuffer[i * ISR_SERVO_I2S_SAMPLES_PER_DESC];
+    desc[i].next_link_ptr = &desc[(i + 1) % ISR_SERVO_I2S_NUM_DESC];
+  }
+
+  // Reset DMA, no interrupt needed as the descriptors loop forever
+  ETS_SLC_INTR_DISABLE();
+
+  SLCC0 |= SLCRXLR | SLCTXLR;
+  SLCC0 &= ~(SLCRXLR | SLCTXLR);
+  SLCIC = 0xFFFFFFFF;
+
+  // Enable and configure DMA
+  SLCC0 &= ~(SLCMM << SLCM);
+  SLCC0 |= (1 << SLCM);
+  SLCRXDC |= SLCBINR | SLCBTNR;
+  SLCRXDC &= ~(SLCBRXFE | SLCBRXEM | SLCBRXFM);
+
+  // The TX (receive) list is not used, but must point to a valid descriptor
+  SLCTXL &= ~(SLCTXLAM << SLCTXLA);
+  SLCRXL &= ~(SLCRXLAM << SLCRXLA);
+  SLCTXL |= (uint32_t) &desc[0] << SLCTXLA;
+  SLCRXL |= (uint32_t) &desc[0] << SLCRXLA;
+
+  // I2S data, bit clock and word select
+  pinMode(3,  FUNCTION_1);
+  pinMode(15, FUNCTION_1);
+  pinMode(2,  FUNCTION_1);
+
+  I2S_CLK_ENABLE();
+  I2SIC = 0x3F;
+  I2SIE = 0;
+
+  // Reset I2S
+  I2SC &= ~(I2SRST);
+  I2SC |= I2SRST;
+  I2SC &= ~(I2SRST);
+
+  // Enable DMA, 16-bit stereo (32 bits per sample)
+  I2SFC &= ~(I2SDE | (I2STXFMM << I2STXFM) | (I2SRXFMM << I2SRXFM));
+  I2SFC |= I2SDE;
+  I2SCC &= ~((I2STXCMM << I2STXCM) | (I2SRXCMM << I2SRXCM));
+
+  // 160MHz / (clock div * bit clock div) = 32 bits per ISR_SERVO_I2S_RESOLUTION_MICRO
+  // => clock div * bit clock div = 5 * ISR_SERVO_I2S_RESOLUTION_MICRO
+  I2SC &= ~(I2STSM | I2SRSM | (I2SBMM << I2SBM) | (I2SBDM << I2SBD) | (I2SCDM << I2SCD));
+  I2SC |= I2SRF | I2SMR | I2SRSM | I2SRMS | (5 << I2SBD) | (ISR_SERVO_I2S_RESOLUTION_MICRO << I2SCD);
+
+  // Start DMA, then transmission
+  SLCRXL |= SLCRXLS;
+  I2SC |= I2STXS;
+
+  numServos = 0;
+
+  ISR_SERVO_LOGERROR3("Starting I2S DMA OK, samples =", ISR_SERVO_I2S_NUM_SAMPLES, ", desc =", ISR_SERVO_I2S_NUM_DESC);
+}
+
+void ESP8266_I2S_Servo::stop()
+{
+  if (numServos < 0)
+    return;
+
+  I2SC &= ~(I2STXS);
+  SLCRXL |= SLCRXLE;
+
+  numServos = -1;
+}
+
+// render the pulse of servoIndex for pulseWidth in microsecs
+void ESP8266_I2S_Servo::render(const uint8_t& servoIndex, const uint16_t& pulseWidth)
+{
+  servo[servoIndex].pulseWidth = pulseWidth;
+
+  renderer.setChannel(servoIndex, pulseWidth / ISR_SERVO_I2S_RESOLUTION_MICRO);
+}
+
+int8_t ESP8266_I2S_Servo::setupServo(const uint8_t& channel, const uint16_t& min, const uint16_t& max)
+{
+  if (channel >= MAX_SERVOS)
+    return -1;
+
+  if (numServos < 0)
+    init();
+
+  if (servo[channel].attached)
+    return -1;
+
+  servo[channel].attached = true;
+  servo[channel].min      = min;
+  servo[channel].max      = max;
+  servo[channel].position = 0;
+
+  render(channel, min);
+
+  numServos++;
+
+  ISR_SERVO_LOGDEBUG3("Channel =", channel, ", pulseWidth =", servo[channel].pulseWidth);
+
+  return channel;
+}
+
+bool ESP8266_I2S_Servo::setPosition(const uint8_t& servoIndex, const uint16_t& position)
+{
+  if ( (servoIndex >= MAX_SERVOS) || !servo[servoIndex].attached )
+    return false;
+
+  servo[servoIndex].position = position;
+
+  render(servoIndex, map(position, 0, 180, servo[servoIndex].min, servo[servoIndex].max));
+
+  ISR_SERVO_LOGDEBUG3("Idx =", servoIndex, ", pos =", position);
+
+  return true;
+}
+
+int ESP8266_I2S_Servo::getPosition(const uint8_t& servoIndex)
+{
+  if ( (servoIndex >= MAX_SERVOS) || !servo[servoIndex].attached )
+    return -1;
+
+  return servo[servoIndex].position;
+}
+
+bool ESP8266_I2S_Servo::setPulseWidth(const uint8_t& servoIndex, uint16_t& pulseWidth)
+{
+  if ( (servoIndex >= MAX_SERVOS) || !servo[servoIndex].attached )
+    return false;
+
+  if (pulseWidth < servo[servoIndex].min)
+    pulseWidth = servo[servoIndex].min;
+  else if (pulseWidth > servo[servoIndex].max)
+    pulseWidth = servo[servoIndex].max;
+
+  servo[servoIndex].position = map(pulseWidth, servo[servoIndex].min, servo[servoIndex].max, 0, 180);
+
+  render(servoIndex, pulseWidth);
+
+  ISR_SERVO_LOGDEBUG3("Idx =", servoIndex, ", pulseWidth =", pulseWidth);
+
+  return true;
+}
+
+unsigned int ESP8266_I2S_Servo::getPulseWidth(const uint8_t& servoIndex)
+{
+  if ( (servoIndex >= MAX_SERVOS) || !servo[servoIndex].attached )
+    return 0;
+
+  // Actual rendered pulse width, truncated to ISR_SERVO_I2S_RESOLUTION_MICRO
+  return renderer.getChannel(servoIndex) * ISR_SERVO_I2S_RESOLUTION_MICRO;
+}
+
+void ESP8266_I2S_Servo::deleteServo(const uint8_t& servoIndex)
+{
+  if ( (servoIndex >= MAX_SERVOS) || !servo[servoIndex].attached )
+    return;
+
+  render(servoIndex, 0);
+
+  memset(&servo[servoIndex], 0, sizeof(servo_t));
+
+  numServos--;
+}
+
+int8_t ESP8266_I2S_Servo::getNumServos()
+{
+  return numServos;
+}
+
+#endif    // ESP8266_I2S_SERVO_IMPL_H
@@ -0,0 +1,114 @@
+/****************************************************************************************************************************
+  ESP8266_I2S_Servo_Renderer.h
+  For ESP8266 boards
+  Written by Khoi Hoang
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP8266_ISR_Servo
+  Licensed under MIT license
+
+  Renders the servo pulses of a whole frame (REFRESH_INTERVAL) as a bit-stream, one 32-bit I2S sample per time slot.
+  Bit c of each 16-bit half of a sample is the level of channel c during that time slot. Both halves are identical,
+  so that the shift registers latched by the I2S word-select line see the same levels whichever half is latched.
+
+  Plain C++, no Arduino dependency, so that it can be used and checked on any host.
+
+  Version: 1.3.0
+
+  Version Modified By   Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang      04/12/2019 Initial coding
+  1.0.1   K Hoang      05/12/2019 Add more features getPosition and getPulseWidth. Optimize.
+  1.0.2   K Hoang      20/12/2019 Add more Blynk examples.Change example names to avoid duplication.
+  1.1.0   K Hoang      03/01/2021 Fix bug. Add TOC and Version String.
+  1.2.0   K Hoang      18/05/2021 Update to match new ESP8266 core v3.0.0
+  1.3.0   K Hoang      28/02/2022 Convert to `h-only` style. Optimize code by using passing by `reference`
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef ESP8266_I2S_SERVO_RENDERER_H
+#define ESP8266_I2S_SERVO_RENDERER_H
+
+#include <stdint.h>
+#include <string.h>
+
+class ESP8266_I2S_Servo_Renderer
+{
+  public:
+    // maximum number of channels, one per bit of a 16-bit half sample
+    const static uint8_t MAX_CHANNELS = 16;
+
+    // buffer must hold numSamples 32-bit samples, and stays owned by the caller
+    ESP8266_I2S_Servo_Renderer(uint32_t* buffer, const uint16_t& numSamples)
+      : buffer(buffer), numSamples(numSamples)
+    {
+      clear();
+    }
+
+    // all channels LOW for the whole frame
+    void clear()
+    {
+      memset(buffer, 0, numSamples * sizeof(uint32_t));
+      memset(width, 0, sizeof(width));
+    }
+
+    // Set the pulse width of channel, in samples. The channel is HIGH from sample 0 to sample (newWidth - 1)
+    // Only the samples between the old and new pulse ends are rewritten
+    // returns false on wrong channel
+    bool setChannel(const uint8_t& channel, uint16_t newWidth)
+    {
+      if (channel >= MAX_CHANNELS)
+        return false;
+
+      if (newWidth > numSamples)
+        newWidth = numSamples;
+
+      uint32_t  bits = channelBits(channel);
+      uint16_t  sample;
+
+      if (newWidth > width[channel])
+      {
+        for (sample = width[channel]; sample < newWidth; sample++)
+          buffer[sample] |= bits;
+      }
+      else
+      {
+        for (sample = newWidth; sample < width[channel]; sample++)
+          buffer[sample] &= ~bits;
+      }
+
+      width[channel] = newWidth;
+
+      return true;
+    }
+
+    // returns the pulse width of channel in samples, or 0 on wrong channel
+    uint16_t getChannel(const uint8_t& channel) const
+    {
+      return (channel < MAX_CHANNELS) ? width[channel] : 0;
+    }
+
+    // returns the level of channel in sample
+    bool getLevel(const uint8_t& channel, const uint16_t& sample) const
+    {
+      return (channel < MAX_CHANNELS) && (sample < numSamples) && (buffer[sample] & channelBits(channel));
+    }
+
+    uint16_t getNumSamples() const
+    {
+      return numSamples;
+    }
+
+    static uint32_t channelBits(const uint8_t& channel)
+    {
+      return ( (uint32_t) 1 << channel) | ( (uint32_t) 1 << (channel + 16) );
+    }
+
+  private:
+
+    uint32_t* buffer;
+    uint16_t  numSamples;
+    uint16_t  width[MAX_CHANNELS];
+};
+
+#endif    // ESP8266_I2S_SERVO_RENDERER_H
@@ -89,6 +89,73 @@
   #define ISR_SERVO_DEBUG       0
 #endif
 
+// Set to 1 to record the servo edges (and optionally the ISR entry / exit) for dumpTraceVCD() and printTraceStats()
+#ifndef ISR_SERVO_TRACE
+  #define ISR_SERVO_TRACE       0
+#endif
+
+#if ISR_SERVO_MINIMAL_FOOTPRINT
+  #undef ISR_SERVO_TRACE
+  #define ISR_SERVO_TRACE       0
+#endif
+
+// Number of servo slots, up to 16. Fewer slots use less RAM and shorten run()
+#ifndef ISR_SERVO_MAX_SERVOS
+  #define ISR_SERVO_MAX_SERVOS  16
+#endif
+
+#if ( (ISR_SERVO_MAX_SERVOS < 1) || (ISR_SERVO_MAX_SERVOS > 16) )
+  #error ISR_SERVO_MAX_SERVOS must be from 1 to 16
+#endif
+
+// Optional features processed by run() at each frame start. All are left out by ISR_SERVO_MINIMAL_FOOTPRINT,
+// so that only the tick / edge hot path stays in IRAM, but each can be set to 1 again on its own
+// Group updates applied together at the next frame start: setPositions(), setPulseWidths(), moveTo(group)
+#ifndef ISR_SERVO_USE_GROUPS
+  #define ISR_SERVO_USE_GROUPS        (!ISR_SERVO_MINIMAL_FOOTPRINT)
+#endif
+
+// Slew rate limit: setSlewRate(), setMaxMovingServos()
+#ifndef ISR_SERVO_USE_SLEW
+  #define ISR_SERVO_USE_SLEW          (!ISR_SERVO_MINIMAL_FOOTPRINT)
+#endif
+
+// Frame phase alignment and scheduled moves: syncToReference(), schedulePosition(), schedulePulseWidth()
+#ifndef ISR_SERVO_USE_SYNC
+  #define ISR_SERVO_USE_SYNC          (!ISR_SERVO_MINIMAL_FOOTPRINT)
+#endif
+
+// Pulse width to the microsec: setDithering()
+#ifndef ISR_SERVO_USE_DITHER
+  #define ISR_SERVO_USE_DITHER        (!ISR_SERVO_MINIMAL_FOOTPRINT)
+#endif
+
+// Sine oscillators: setOscillator() etc., with their sine table in DRAM
+#ifndef ISR_SERVO_USE_OSCILLATOR
+  #define ISR_SERVO_USE_OSCILLATOR    (!ISR_SERVO_MINIMAL_FOOTPRINT)
+#endif
+
+// setTarget() is only called from the ISR by the scheduled moves, group updates and oscillators, and otherwise stays in flash
+#if (ISR_SERVO_USE_GROUPS || ISR_SERVO_USE_SYNC || ISR_SERVO_USE_OSCILLATOR)
+  #define ISR_SERVO_SET_TARGET_ATTR   IRAM_ATTR
+#else
+  #define ISR_SERVO_SET_TARGET_ATTR
+#endif
+
+// Largest change per frame of the oscillator center and amplitude, in microsecs, and of its phase, in degrees
+#ifndef ISR_SERVO_OSCILLATOR_RAMP
+  #define ISR_SERVO_OSCILLATOR_RAMP         10
+#endif
+
+#ifndef ISR_SERVO_OSCILLATOR_PHASE_RAMP
+  #define ISR_SERVO_OSCILLATOR_PHASE_RAMP   2
+#endif
+
+// Number of events recorded by a capture. Each event uses 8 bytes of RAM
+#ifndef ISR_SERVO_TRACE_SIZE
+  #define ISR_SERVO_TRACE_SIZE  512
+#endif
+
 #define ESP8266_MAX_PIN         17
 #define ESP8266_WRONG_PIN       255
 
@@ -99,13 +166,99 @@
 #define DEFAULT_PULSE_WIDTH     1500      // default pulse width when servo is attached
 #define REFRESH_INTERVAL        20000     // minumim time to refresh servos in microseconds 
 
+// servoIndex returned by setupServo() = (generation << 4) | slot. The generation of a slot is bumped by deleteServo(),
+// so that a stale servoIndex is rejected instead of controlling the servo later set up in the same slot
+#define ISR_SERVO_SLOT_MASK           0x0F
+#define ISR_SERVO_GENERATION_MASK     0x07
+
+// Set of servos, one bit per slot (bit 0 <=> slot 0), used by the group operations
+// The generation of each member servoIndex is kept, so that the group operations reject a member deleted since
+class ESP8266_ISR_Servo_Group
+{
+  public:
+
+    ESP8266_ISR_Servo_Group()
+      : mask(0)
+    {
+      memset(generation, 0, sizeof(generation));
+    }
+
+    // add the servo to the group, returns false on wrong servoIndex
+    bool add(const uint8_t& servoIndex)
+    {
+      if (servoIndex & 0x80)
+        return false;
+
+      mask |= (1 << (servoIndex & ISR_SERVO_SLOT_MASK));
+      generation[servoIndex & ISR_SERVO_SLOT_MASK] = servoIndex >> 4;
+
+      return true;
+    }
+
+    // remove the servo from the group, returns false on wrong servoIndex
+    bool remove(const uint8_t& servoIndex)
+    {
+      if (!contains(servoIndex))
+        return false;
+
+      mask &= ~(1 << (servoIndex & ISR_SERVO_SLOT_MASK));
+
+      return true;
+    }
+
+    bool contains(const uint8_t& servoIndex) const
+    {
+      return !(servoIndex & 0x80) && (mask & (1 << (servoIndex & ISR_SERVO_SLOT_MASK)))
+             && (generation[servoIndex & ISR_SERVO_SLOT_MASK] == (servoIndex >> 4));
+    }
+
+    void clear()
+    {
+      mask = 0;
+    }
+
+    // returns the number of servos in the group
+    uint8_t size() const
+    {
+      return __builtin_popcount(mask);
+    }
+
+    uint16_t getMask() const
+    {
+      return mask;
+    }
+
+    // returns the servoIndex of the member in slot, or -1 if none
+    int8_t getServoIndex(const uint8_t& slot) const
+    {
+      if ( (slot > ISR_SERVO_SLOT_MASK) || !(mask & (1 << slot)) )
+        return -1;
+
+      return (generation[slot] << 4) | slot;
+    }
+
+  private:
+
+    uint16_t mask;
+    uint8_t  generation[16];
+};
+
+// Coherent copy of all servo states, filled by ESP8266_ISR_Servo::snapshot(). Arrays are indexed by slot
+typedef struct
+{
+  uint32_t      frame;                    // frame sequence number, see getFrameCount()
+  uint16_t      allocatedMask;            // slots in use
+  uint16_t      enabledMask;              // slots enabled
+  uint16_t      position[16];             // In degrees
+  uint16_t      pulseWidth[16];           // In microsecs, as currently output
+} ServoSnapshot;
 
 class ESP8266_ISR_Servo
 {
 
   public:
     // maximum number of servos
-    const static uint8_t MAX_SERVOS = 16;
+    const static uint8_t MAX_SERVOS = ISR_SERVO_MAX_SERVOS;
 
     // constructor
     ESP8266_ISR_Servo();
@@ -118,7 +271,7 @@ class ESP8266_ISR_Servo
 
     void IRAM_ATTR run();
 
-    // Bind servo to the timer and pin, return servoIndex
+    // Bind servo to the timer and pin, return servoIndex (generation-tagged, see ISR_SERVO_SLOT_MASK), or -1 on failure
     int8_t setupServo(const uint8_t& pin, const uint16_t& min = MIN_PULSE_WIDTH, const uint16_t& max = MAX_PULSE_WIDTH);
 
     // setPosition will set servo to position in degrees
@@ -156,6 +309,100 @@ class ESP8266_ISR_Servo
     // disables all servos
     void disableAll();
 
+#if ISR_SERVO_USE_SLEW
+
+    // Limit the pulse width change of the servo to maxStep microsecs per frame (REFRESH_INTERVAL)
+    // The foreground only sets the target, run() moves the servo towards it at each frame start
+    // maxStep = 0 (default) disables the limit, the servo jumps to the target
+    // returns true on success or false on wrong servoIndex
+    bool setSlewRate(const uint8_t& servoIndex, const uint16_t& maxStep);
+
+    // Limit the number of slew-limited servos moving at the same time, to bound the current drawn from the power rail
+    // The others hold their position until a moving servo reaches its target. 0 (default) means no limit
+    void setMaxMovingServos(const uint8_t& maxMoving);
+
+#endif
+
+    // returns true if the servo has not reached its target yet
+    bool isMoving(const uint8_t& servoIndex);
+
+#if ISR_SERVO_USE_DITHER
+
+    // With dithering, the pulse width is set to the microsec instead of being truncated to TIMER_INTERVAL_MICRO:
+    // run() alternates the falling edge between the 2 nearest timer counts from frame to frame, so that the average
+    // pulse width is the commanded one. Takes effect from the next setPosition() / setPulseWidth()
+    // returns true on success or false on wrong servoIndex
+    bool setDithering(const uint8_t& servoIndex, const bool& dithering);
+
+    bool isDithering(const uint8_t& servoIndex);
+
+#endif
+
+#if ISR_SERVO_USE_OSCILLATOR
+
+    // Bind the servo to an oscillator, evaluated by run() at each frame start with integer math only:
+    // pulse width = center + amplitude * sin(2 * PI * (frequency * t + phase / 360)), within the servo min / max
+    // center and amplitude in microsecs, frequency in milliHz (up to 500000 / REFRESH_INTERVAL Hz), phase in degrees
+    // The output never steps: a new oscillator starts from the current pulse width with no amplitude, and changes of
+    // center, amplitude and phase are ramped by run(), by at most ISR_SERVO_OSCILLATOR_RAMP microsecs and
+    // ISR_SERVO_OSCILLATOR_PHASE_RAMP degrees per frame. Calling it again on an oscillating servo keeps its phase
+    // running. Updates from setPosition() etc. are overridden
+    // returns true on success or false on wrong servoIndex or frequency, disabled servo or bad pin
+    bool setOscillator(const uint8_t& servoIndex, const uint16_t& center, const uint16_t& amplitude,
+                       const uint16_t& frequency, const uint16_t& phase = 0);
+
+    // Change the frequency of all oscillators of the group in the same frame, keeping their phase running
+    // Members not bound to an oscillator are left alone, as by syncOscillators()
+    bool setOscillatorFrequency(const ESP8266_ISR_Servo_Group& group, const uint16_t& frequency);
+
+    // Restart the oscillators of the group together, so that they only differ by their phase
+    // The accumulators are aligned at once, and each output then ramps to its new phase as for a phase change
+    bool syncOscillators(const ESP8266_ISR_Servo_Group& group);
+
+    // Unbind the servo from its oscillator, holding its current pulse width
+    bool stopOscillator(const uint8_t& servoIndex);
+
+    bool isOscillating(const uint8_t& servoIndex);
+
+#endif
+
+#if ISR_SERVO_USE_GROUPS
+
+    // Group operations. Values are given one per group member, in ascending slot order (servoIndex & ISR_SERVO_SLOT_MASK).
+    // All members are validated in a single pass, then the new pulse widths are published to the ISR at once
+    // and take effect together at the start of the next frame.
+    // returns true on success, or false (and nothing changed) if any member is deleted, not enabled or has bad pin
+    bool setPositions(const ESP8266_ISR_Servo_Group& group, const uint16_t positions[]);
+
+    // min and max for each individual servo are enforced
+    bool setPulseWidths(const ESP8266_ISR_Servo_Group& group, const uint16_t pulseWidths[]);
+
+    // moves all servos of the group to the same position in degrees
+    bool moveTo(const ESP8266_ISR_Servo_Group& group, const uint16_t& position);
+
+#endif
+
+    // enables all servos of the group. returns false (and nothing changed) if any member is deleted or has bad pin
+    bool enable(const ESP8266_ISR_Servo_Group& group);
+
+    // disables all servos of the group, ending the pulses in progress at once
+    // returns false (and nothing changed) if any member is deleted
+    bool disable(const ESP8266_ISR_Servo_Group& group);
+
+    // Updates moving the pulse width less than deadband (in microsecs) from the last applied one are suppressed,
+    // without touching the ISR-shared data. Updates to the same position or timer count are always suppressed.
+    // returns true on success or false on wrong servoIndex
+    bool setDeadband(const uint8_t& servoIndex, const uint16_t& deadband);
+
+    // same as setDeadband(), with deadband in degrees converted using the servo min / max
+    bool setDeadbandDegrees(const uint8_t& servoIndex, const uint16_t& degrees);
+
+    // returns the numbers of applied and suppressed updates since setupServo() or resetUpdateStats()
+    // returns false on wrong servoIndex
+    bool getUpdateStats(const uint8_t& servoIndex, unsigned long& applied, unsigned long& suppressed);
+
+    void resetUpdateStats(const uint8_t& servoIndex);
+
     // enables the specified servo if it's currently disabled,
     // and vice-versa
     bool toggle(const uint8_t& servoIndex);
@@ -163,6 +410,48 @@ class ESP8266_ISR_Servo
     // returns the number of used servos
     int8_t getNumServos();
 
+    // returns the number of frames (REFRESH_INTERVAL) started since the first setupServo()
+    uint32_t getFrameCount()
+    {
+      return frameCount;
+    }
+
+    // Copy the state of all servos in one pass, without disabling interrupts and without logging
+    // All values belong to the same frame: the copy is retried if run() started a new frame meanwhile
+    void snapshot(ServoSnapshot& snap);
+
+#if ISR_SERVO_USE_SYNC
+
+    // Phase-align the frames to an external time base, shared by several boards
+    // refTime is the reference time now, in microsecs (e.g. sync packet timestamp), offset is added to it (e.g. transit delay)
+    // refTime must not wrap: a 32-bit microsecs clock wraps every 71.6 minutes, not a multiple of REFRESH_INTERVAL,
+    // so extend it to 64 bits first. Reference frame N starts at reference time N * REFRESH_INTERVAL, N modulo 2^32
+    // (about 994 days), and schedulePosition() handles that wrap. The frame number is aligned at once, while the phase
+    // error is corrected gradually, by trimming the next frames by at most setMaxFrameTrim() each
+    void syncToReference(const uint64_t& refTime, const int32_t& offset = 0);
+
+    // Maximum frame length change for phase correction, in microsecs per frame. Default is TIMER_INTERVAL_MICRO (10us)
+    void setMaxFrameTrim(const uint16_t& maxTrim);
+
+    // returns the phase error still to be corrected, in microsecs. Positive when the local frames are late
+    int32_t getPhaseError();
+
+    // returns the current frame number in the reference time base
+    uint32_t getReferenceFrame()
+    {
+      return frameCount + frameOffset;
+    }
+
+    // Schedule the servo to move to position in degrees (or pulseWidth in microsecs) at the start of the reference frame atFrame
+    // Only one move per servo can be scheduled, a new one replaces it. A frame already started applies at the next frame
+    // getPosition() and snapshot() report the move once applied. Any other update before then cancels it
+    // returns true on success or false on wrong servoIndex
+    bool schedulePosition(const uint8_t& servoIndex, const uint16_t& position, const uint32_t& atFrame);
+
+    bool schedulePulseWidth(const uint8_t& servoIndex, uint16_t& pulseWidth, const uint32_t& atFrame);
+
+#endif
+
     // returns the number of available servos
     int8_t getNumAvailableServos() 
     {
@@ -172,13 +461,155 @@ class ESP8266_ISR_Servo
         return MAX_SERVOS - numServos;
     };
 
+#if ISR_SERVO_TRACE
+
+    // Start a new capture, stopping when ISR_SERVO_TRACE_SIZE events are recorded or on stopTrace()
+    // With traceISR, run() entry / exit are recorded too, for the runs with a servo edge or lasting at least
+    // minISRDuration microsecs. Recording every run uses 2 events per TIMER_INTERVAL_MICRO, so that a whole frame
+    // needs ISR_SERVO_TRACE_SIZE > 2 * REFRESH_INTERVAL / TIMER_INTERVAL_MICRO = 4000 events (32KB) for printTraceStats()
+    // to report a period: raise minISRDuration above the usual run() duration to keep only the slow ones instead
+    void startTrace(const bool& traceISR = false, const uint16_t& minISRDuration = 0);
+
+    // Stop the capture before the buffer is full, to dump or summarise the events recorded so far
+    void stopTrace();
+
+    // returns true when the capture is over, buffer full or stopped
+    bool isTraceDone();
+
+    // Write the captured events as a Value Change Dump (VCD) file, viewable with GTKWave
+    void dumpTraceVCD(Print& output);
+
+    // Print pulse width, period and period jitter (max - min) of each servo from the captured events, in microsecs
+    void printTraceStats(Print& output);
+
+#endif
+
   private:
 
     void init();
 
+    // called by run() at the end of each frame, before the rising edges of the next one
+    void IRAM_ATTR startFrame();
+
+#if ISR_SERVO_USE_SLEW
+
+    // move the slew-limited servos towards their target
+    void IRAM_ATTR slewServos();
+
+#endif
+
+#if ISR_SERVO_USE_DITHER
+
+    // alternate the count of the dithered servos at their target between target and target + 1
+    void IRAM_ATTR ditherServos();
+
+#endif
+
+#if ISR_SERVO_USE_OSCILLATOR
+
+    // advance the oscillators and set the target of their servos
+    void IRAM_ATTR oscillateServos();
+
+    // returns sin(2 * PI * phase / 2^32) in Q15, from a quarter-wave table with linear interpolation
+    static int32_t IRAM_ATTR sine(const uint32_t phase);
+
+    // returns value moved towards target by at most step
+    static uint16_t IRAM_ATTR rampTo(const uint16_t value, const uint16_t target, const uint16_t step)
+    {
+      if (value + step < target)
+        return value + step;
+
+      if (value > target + step)
+        return value - step;
+
+      return target;
+    }
+
+    // phase accumulator increment per frame for frequency in milliHz
+    uint32_t oscillatorIncrement(const uint16_t& frequency)
+    {
+      return ( ( (uint64_t) frequency << 32) * REFRESH_INTERVAL) / 1000000000ULL;
+    }
+
+#endif
+
+    // set target of servo, reached at once or by slewServos()
+    void ISR_SERVO_SET_TARGET_ATTR setTarget(const uint8_t servoIndex, const unsigned long count, const uint8_t fraction)
+    {
+      servo[servoIndex].target    = count;
+      servo[servoIndex].fraction  = fraction;
+
+#if ISR_SERVO_USE_SLEW
+
+      if (servo[servoIndex].maxStep)
+      {
+        slewingMask |= (1 << servoIndex);
+
+        return;
+      }
+
+#endif
+
+      servo[servoIndex].count = count;
+    }
+
+    // returns true if the servo in slot is dithered, always false without ISR_SERVO_USE_DITHER
+    bool isDithered(const uint8_t& slot)
+    {
+#if ISR_SERVO_USE_DITHER
+      return (ditherMask & (1 << slot));
+#else
+      (void) slot;
+
+      return false;
+#endif
+    }
+
+#if ISR_SERVO_USE_SYNC
+
+    // stage a scheduled pulse width and position, applied by run() at the start of reference frame atFrame
+    bool scheduleWidth(const uint8_t& slot, const uint16_t& pulseWidth, const uint16_t& position, const uint32_t& atFrame);
+
+#endif
+
     // find the first available slot
     int8_t findFirstFreeSlot();
 
+    // returns the slot of servoIndex, or -1 if servoIndex is wrong, stale or its slot is free
+    int8_t slotOf(const uint8_t& servoIndex)
+    {
+      uint8_t slot = servoIndex & ISR_SERVO_SLOT_MASK;
+
+      if ( (servoIndex & 0x80) || !(allocatedMask & (1 << slot)) || (generation[slot] != (servoIndex >> 4)) )
+        return -1;
+
+      return slot;
+    }
+
+    int8_t handleOf(const uint8_t& slot)
+    {
+      return (generation[slot] << 4) | slot;
+    }
+
+    // returns true if all members of group are still set up, i.e. not deleted since added to group
+    bool isGroupValid(const ESP8266_ISR_Servo_Group& group);
+
+    // returns true if all members of group are valid, enabled and have good pin
+    bool isGroupReady(const ESP8266_ISR_Servo_Group& group);
+
+    // returns true if pulseWidth must be applied, false if suppressed by change detection or deadband
+    bool filterUpdate(const uint8_t& servoIndex, const uint16_t& pulseWidth);
+
+    // set pulse width of a single servo immediately, dropping any group update or scheduled move still pending for it
+    void setWidth(const uint8_t& servoIndex, const uint16_t& pulseWidth);
+
+#if ISR_SERVO_USE_GROUPS
+
+    // stage pulse width for all servos in mask, to be applied by run() at the next frame start, replacing scheduled moves
+    void publishWidths(const uint16_t& mask, const uint16_t pulseWidth[]);
+
+#endif
+
     typedef struct
     {
       uint8_t       pin;                  // pin servo connected to
@@ -187,13 +618,93 @@ class ESP8266_ISR_Servo
       bool          enabled;              // true if enabled
       uint16_t      min;
       uint16_t      max;
+      unsigned long target;               // count to reach when slew-limited
+      uint8_t       fraction;             // In microsecs, added to target * TIMER_INTERVAL_MICRO when dithering
+#if ISR_SERVO_USE_GROUPS
+      unsigned long pendingCount;         // count to be applied at the next frame start
+      uint8_t       pendingFraction;
+#endif
+#if ISR_SERVO_USE_SLEW
+      uint16_t      maxStep;              // In timer counts per frame, 0 if not slew-limited
+#endif
+#if ISR_SERVO_USE_SYNC
+      unsigned long scheduledCount;       // count to be applied at the start of reference frame scheduledFrame
+      uint32_t      scheduledFrame;
+      uint8_t       scheduledFraction;
+      uint16_t      scheduledPosition;    // In degrees, copied to position when the move is applied
+#endif
+#if ISR_SERVO_USE_DITHER
+      uint8_t       ditherError;          // dithering error accumulator, in microsecs
+#endif
+#if ISR_SERVO_USE_OSCILLATOR
+      uint16_t      oscCenter;            // In microsecs, ramping to oscCenterTarget
+      uint16_t      oscAmplitude;         // In microsecs, ramping to oscAmplitudeTarget
+      uint32_t      oscPhase;             // oscillator phase accumulator, 2^32 is a full period
+      uint32_t      oscIncrement;         // added to oscPhase at each frame
+      uint32_t      oscPhaseOffset;       // added to oscPhase when evaluated, ramping to oscPhaseTarget
+      uint16_t      oscCenterTarget;      // as set by setOscillator()
+      uint16_t      oscAmplitudeTarget;
+      uint32_t      oscPhaseTarget;
+#endif
     } servo_t;
 
     volatile servo_t servo[MAX_SERVOS];
 
+    // Foreground-only data, never accessed by run()
+    typedef struct
+    {
+      uint16_t      lastPulseWidth;       // last applied pulse width in microsecs, including pending ones
+      uint16_t      deadband;             // In microsecs
+      unsigned long applied;              // number of applied updates
+      unsigned long suppressed;           // number of suppressed updates
+      bool          byPosition;           // true if position was set in degrees, not mapped back from a pulse width
+#if ISR_SERVO_USE_SYNC
+      bool          scheduled;            // a move was scheduled since the last filterUpdate()
+#endif
+    } servo_filter_t;
+
+    servo_filter_t filter[MAX_SERVOS];
+
+#if ISR_SERVO_USE_GROUPS
+    // servos with a pendingCount waiting to be applied by run()
+    volatile uint16_t pendingMask;
+#endif
+
+#if ISR_SERVO_USE_SLEW
+    // slew-limited servos with count != target
+    volatile uint16_t slewingMask;
+
+    // slew-limited servos currently allowed to move
+    volatile uint16_t movingMask;
+
+    // maximum number of slew-limited servos moving together, 0 means no limit
+    volatile uint8_t  maxMovingServos;
+#endif
+
+#if ISR_SERVO_USE_SYNC
+    // servos with a scheduledCount
+    volatile uint16_t scheduledMask;
+#endif
+
+#if ISR_SERVO_USE_DITHER
+    // servos with dithering
+    volatile uint16_t ditherMask;
+#endif
+
+#if ISR_SERVO_USE_OSCILLATOR
+    // servos bound to their oscillator
+    volatile uint16_t oscillatorMask;
+#endif
+
     // actual number of servos in use (-1 means uninitialized)
     volatile int8_t numServos;
 
+    // slots in use, including the disabled ones
+    uint16_t allocatedMask;
+
+    // generation of each slot, bumped when the slot is freed
+    uint8_t generation[MAX_SERVOS];
+
     // Use 10 microsecs timer, just  fine enough to control Servo, normally requiring pulse width (PWM) 500-2000us in 20ms.
 #define TIMER_INTERVAL_MICRO        10
 
@@ -202,8 +713,62 @@ class ESP8266_ISR_Servo
     // For example, servo1 uses pulse width 1000us => turned ON when timerCount = 1, turned OFF when timerCount = 1000 / TIMER_INTERVAL_MICRO = 100
     volatile unsigned long timerCount;
 
+    // incremented by run() at each frame start
+    volatile uint32_t frameCount;
+
+    // Seqlock with snapshot(), odd while run() updates the counts at frame start
+    volatile uint32_t updateSeq;
+
+    // length of the current frame in timer counts, normally REFRESH_INTERVAL / TIMER_INTERVAL_MICRO
+    volatile uint16_t frameLength;
+
+#if ISR_SERVO_USE_SYNC
+    // reference frame number = frameCount + frameOffset
+    volatile int32_t  frameOffset;
+
+    // phase error still to be corrected, in timer counts, and maximum correction per frame
+    volatile int32_t  phaseError;
+    volatile uint16_t maxFrameTrim;
+#endif
+
     // Init ESP32 timer 0
     ESP8266Timer ITimer;
+
+#if ISR_SERVO_TRACE
+
+    // id of the run() entry / exit events, servo edges use the slot as id
+#define ISR_SERVO_TRACE_ISR_ID      MAX_SERVOS
+
+    typedef struct
+    {
+      uint32_t      cycle;                // ESP.getCycleCount() at the event
+      uint8_t       id;                   // slot, or ISR_SERVO_TRACE_ISR_ID
+      uint8_t       level;                // new pin level, or 1 / 0 for run() entry / exit
+    } trace_event_t;
+
+    trace_event_t     traceBuffer[ISR_SERVO_TRACE_SIZE];
+    volatile uint16_t traceCount;
+    volatile bool     traceActive;
+    volatile bool     traceISR;
+
+    // run() entry event index, and shortest run() duration recorded without servo edge, in cycles
+    uint16_t          traceISREntry;
+    uint32_t          traceISRMinCycles;
+
+    void IRAM_ATTR traceEvent(const uint8_t id, const uint8_t level)
+    {
+      if (traceActive)
+      {
+        traceBuffer[traceCount].cycle  = ESP.getCycleCount();
+        traceBuffer[traceCount].id     = id;
+        traceBuffer[traceCount].level  = level;
+
+        if (++traceCount >= ISR_SERVO_TRACE_SIZE)
+          traceActive = false;
+      }
+    }
+
+#endif
 };
 
 //extern ESP8266_ISR_Servo ISR_Servo;  // create servo object to control up to 16 servos
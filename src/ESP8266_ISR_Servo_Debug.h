@@ -47,12 +47,39 @@
 
 //////////////////////////////////////////
 
+// Set to 1 to strip all debug strings and the frame start features (see ISR_SERVO_USE_GROUPS etc.),
+// keeping only the tick / edge hot path in IRAM
+#ifndef ISR_SERVO_MINIMAL_FOOTPRINT
+  #define ISR_SERVO_MINIMAL_FOOTPRINT   0
+#endif
+
+#if ISR_SERVO_MINIMAL_FOOTPRINT
+  #undef ISR_SERVO_DEBUG
+  #define ISR_SERVO_DEBUG               0
+#endif
+
 #ifndef ISR_SERVO_DEBUG
   #define ISR_SERVO_DEBUG               1
 #endif
 
 //////////////////////////////////////////
 
+#if ISR_SERVO_MINIMAL_FOOTPRINT
+
+#define ISR_SERVO_LOGERROR(x)
+#define ISR_SERVO_LOGERROR0(x)
+#define ISR_SERVO_LOGERROR1(x,y)
+#define ISR_SERVO_LOGERROR2(x,y,z)
+#define ISR_SERVO_LOGERROR3(x,y,z,w)
+
+#define ISR_SERVO_LOGDEBUG(x)
+#define ISR_SERVO_LOGDEBUG0(x)
+#define ISR_SERVO_LOGDEBUG1(x,y)
+#define ISR_SERVO_LOGDEBUG2(x,y,z)
+#define ISR_SERVO_LOGDEBUG3(x,y,z,w)
+
+#else
+
 #if !defined(ISR_SERVO_DEBUG_OUTPUT)
   #define ISR_SERVO_DEBUG_OUTPUT    Serial
 #endif
@@ -85,6 +112,8 @@ const char ISR_SERVO_SP[]    = " ";
 #define ISR_SERVO_LOGDEBUG2(x,y,z)    if(ISR_SERVO_DEBUG>1) { ISR_SERVO_PRINT_MARK; ISR_SERVO_PRINT(x); ISR_SERVO_PRINT_SP; ISR_SERVO_PRINT(y); ISR_SERVO_PRINT_SP; ISR_SERVO_PRINTLN(z); }
 #define ISR_SERVO_LOGDEBUG3(x,y,z,w)  if(ISR_SERVO_DEBUG>1) { ISR_SERVO_PRINT_MARK; ISR_SERVO_PRINT(x); ISR_SERVO_PRINT_SP; ISR_SERVO_PRINT(y); ISR_SERVO_PRINT_SP; ISR_SERVO_PRINT(z); ISR_SERVO_PRINT_SP; ISR_SERVO_PRINTLN(w); }
 
+#endif    // ISR_SERVO_MINIMAL_FOOTPRINT
+
 //////////////////////////////////////////
 
 
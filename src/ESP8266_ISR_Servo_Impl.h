@@ -58,8 +58,26 @@ void IRAM_ATTR ESP8266_ISR_Servo_Handler()
   ISR_Servo.run();
 }
 
+#if ISR_SERVO_USE_OSCILLATOR
+
+// First quarter of a sine period in 64 steps, Q15. Not PROGMEM: read by run(), so kept in DRAM
+static const int16_t ISR_SERVO_SINE_TABLE[65] =
+{
+      0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+   6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+  12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+  18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+  23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+  27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+  30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+  32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+  32767
+};
+
+#endif    // ISR_SERVO_USE_OSCILLATOR
+
 ESP8266_ISR_Servo::ESP8266_ISR_Servo()
-  : numServos (-1)
+  : numServos (-1), allocatedMask (0)
 {
 }
 
@@ -83,67 +101,410 @@ void ESP8266_ISR_Servo::init()
     servo[servoIndex].enabled  = false;
     // Intentional bad pin, good only from 0-16 for Digital, A0 = 17
     servo[servoIndex].pin      = ESP8266_WRONG_PIN;
+
+    memset((void*) &filter[servoIndex], 0, sizeof (servo_filter_t));
   }
 
   numServos   = 0;
+  allocatedMask = 0;
+  memset(generation, 0, sizeof(generation));
+
+#if ISR_SERVO_USE_GROUPS
+  pendingMask = 0;
+#endif
+
+#if ISR_SERVO_USE_SLEW
+  slewingMask = 0;
+  movingMask  = 0;
+  maxMovingServos = 0;
+#endif
+
+#if ISR_SERVO_TRACE
+  traceCount  = 0;
+  traceActive = false;
+  traceISR    = false;
+  traceISREntry     = 0;
+  traceISRMinCycles = 0;
+#endif
 
   // Init timerCount
   timerCount  = 1;
+  frameCount  = 0;
+  updateSeq   = 0;
+  frameLength = REFRESH_INTERVAL / TIMER_INTERVAL_MICRO;
+
+#if ISR_SERVO_USE_SYNC
+  frameOffset = 0;
+  phaseError  = 0;
+  maxFrameTrim  = 1;
+  scheduledMask = 0;
+#endif
+
+#if ISR_SERVO_USE_DITHER
+  ditherMask    = 0;
+#endif
+
+#if ISR_SERVO_USE_OSCILLATOR
+  oscillatorMask  = 0;
+#endif
 }
 
 
+#if ISR_SERVO_MINIMAL_FOOTPRINT
+
+// Direct GPIO register writes, much shorter in IRAM than digitalWrite(). GPIO16 has its own register, A0 (17) is input only
+#define ISR_SERVO_WRITE_PIN(pin, level)                                 \
+  do                                                                    \
+  {                                                                     \
+    const uint8_t writePin = (pin);                                     \
+                                                                        \
+    if (writePin < 16)                                                  \
+    {                                                                   \
+      if (level)                                                        \
+        GPOS = (1 << writePin);                                         \
+      else                                                              \
+        GPOC = (1 << writePin);                                         \
+    }                                                                   \
+    else if (writePin == 16)                                            \
+    {                                                                   \
+      GP16O = (level);                                                  \
+    }                                                                   \
+  } while (0)
+
+#else
+
+#define ISR_SERVO_WRITE_PIN(pin, level)     digitalWrite(pin, level)
+
+#endif
+
 void IRAM_ATTR ESP8266_ISR_Servo::run()
 {
   static int servoIndex;
 
+#if ISR_SERVO_TRACE
+
+  if (traceISR)
+  {
+    traceISREntry = traceCount;
+    traceEvent(ISR_SERVO_TRACE_ISR_ID, 1);
+  }
+
+#endif
+
   for (servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
   {
-    if ( servo[servoIndex].enabled  && (servo[servoIndex].pin <= ESP8266_MAX_PIN) )
+    // servo[] is volatile : read the pin once
+    uint8_t pin = servo[servoIndex].pin;
+
+    if ( servo[servoIndex].enabled  && (pin <= ESP8266_MAX_PIN) )
     {
       if ( timerCount == servo[servoIndex].count )
       {
         // PWM to LOW, will be HIGH again when timerCount = 1
-        digitalWrite(servo[servoIndex].pin, LOW);
+        ISR_SERVO_WRITE_PIN(pin, LOW);
+
+#if ISR_SERVO_TRACE
+        traceEvent(servoIndex, LOW);
+#endif
       }
       else if (timerCount == 1)
       {
         // PWM to HIGH, will be LOW again when timerCount = servo[servoIndex].count
-        digitalWrite(servo[servoIndex].pin, HIGH);
+        ISR_SERVO_WRITE_PIN(pin, HIGH);
+
+#if ISR_SERVO_TRACE
+        traceEvent(servoIndex, HIGH);
+#endif
       }
     }
   }
 
-  // Reset when reaching 20000us / 10us = 2000
-  if (timerCount++ >= REFRESH_INTERVAL / TIMER_INTERVAL_MICRO)
+  // Reset when reaching 20000us / 10us = 2000, or the trimmed frame length while syncing
+  if (timerCount++ >= frameLength)
   {
     ISR_SERVO_LOGDEBUG("Reset count");
 
     timerCount = 1;
+
+    startFrame();
+  }
+
+#if ISR_SERVO_TRACE
+
+  if (traceISR && traceActive)
+  {
+    // Drop the entry of a short run() without servo edge, to save the buffer for the interesting ones
+    if ( (traceCount == traceISREntry + 1) && (ESP.getCycleCount() - traceBuffer[traceISREntry].cycle < traceISRMinCycles) )
+      traceCount = traceISREntry;
+    else
+      traceEvent(ISR_SERVO_TRACE_ISR_ID, 0);
   }
+
+#endif
 }
 
+void IRAM_ATTR ESP8266_ISR_Servo::startFrame()
+{
+#if (ISR_SERVO_USE_SYNC || ISR_SERVO_USE_GROUPS)
+  uint8_t servoIndex;
+#endif
+
+  updateSeq++;
 
-// find the first available slot
-// return -1 if none found
-int8_t ESP8266_ISR_Servo::findFirstFreeSlot()
+  frameCount++;
+
+#if ISR_SERVO_USE_SYNC
+
+  // Trim this frame to absorb the phase error, a little at a time
+  frameLength = REFRESH_INTERVAL / TIMER_INTERVAL_MICRO;
+
+  if (phaseError)
+  {
+    int32_t trim = phaseError;
+
+    if (trim > maxFrameTrim)
+      trim = maxFrameTrim;
+    else if (trim < -maxFrameTrim)
+      trim = -maxFrameTrim;
+
+    frameLength -= trim;
+    phaseError  -= trim;
+  }
+
+  // Moves scheduled for this reference frame
+  if (scheduledMask)
+  {
+    for (servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+    {
+      if ( (scheduledMask & (1 << servoIndex))
+           && ( (int32_t) (frameCount + frameOffset - servo[servoIndex].scheduledFrame) >= 0 ) )
+      {
+        setTarget(servoIndex, servo[servoIndex].scheduledCount, servo[servoIndex].scheduledFraction);
+        servo[servoIndex].position = servo[servoIndex].scheduledPosition;
+        scheduledMask &= ~(1 << servoIndex);
+      }
+    }
+  }
+
+#endif
+
+#if ISR_SERVO_USE_GROUPS
+
+  // Apply the group updates together, before the rising edges of the new frame
+  if (pendingMask)
+  {
+    for (servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+    {
+      if (pendingMask & (1 << servoIndex))
+        setTarget(servoIndex, servo[servoIndex].pendingCount, servo[servoIndex].pendingFraction);
+    }
+
+    pendingMask = 0;
+  }
+
+#endif
+
+#if ISR_SERVO_USE_OSCILLATOR
+
+  // Oscillators override the updates above
+  if (oscillatorMask)
+    oscillateServos();
+
+#endif
+
+#if ISR_SERVO_USE_SLEW
+
+  if (slewingMask)
+    slewServos();
+
+#endif
+
+#if ISR_SERVO_USE_DITHER
+
+  if (ditherMask)
+    ditherServos();
+
+#endif
+
+  updateSeq++;
+}
+
+#if ISR_SERVO_USE_SLEW
+
+void IRAM_ATTR ESP8266_ISR_Servo::slewServos()
 {
-  // all slots are used
-  if (numServos >= MAX_SERVOS)
-    return -1;
+  uint8_t       servoIndex;
+  uint8_t       numMoving = 0;
+  unsigned long count;
 
-  // return the first slot with no count (i.e. free)
-  for (int8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  // Servos already moving keep going until they reach their target
+  movingMask &= slewingMask;
+
+  for (servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if (movingMask & (1 << servoIndex))
+      numMoving++;
+  }
+
+  // Then admit the waiting ones, as long as the budget allows
+  for (servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if ( (maxMovingServos != 0) && (numMoving >= maxMovingServos) )
+      break;
+
+    if ( (slewingMask & ~movingMask) & (1 << servoIndex) )
+    {
+      movingMask |= (1 << servoIndex);
+      numMoving++;
+    }
+  }
+
+  for (servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
   {
-    if (servo[servoIndex].enabled == false)
+    if ( !(movingMask & (1 << servoIndex)) )
+      continue;
+
+    count = servo[servoIndex].count;
+
+    if (count + servo[servoIndex].maxStep < servo[servoIndex].target)
+      count += servo[servoIndex].maxStep;
+    else if (count > servo[servoIndex].target + servo[servoIndex].maxStep)
+      count -= servo[servoIndex].maxStep;
+    else
+      count = servo[servoIndex].target;
+
+    servo[servoIndex].count = count;
+
+    if (count == servo[servoIndex].target)
     {
-      ISR_SERVO_LOGDEBUG1("Index =", servoIndex);
+      slewingMask &= ~(1 << servoIndex);
+      movingMask  &= ~(1 << servoIndex);
+    }
+  }
+}
+
+#endif    // ISR_SERVO_USE_SLEW
+
+#if ISR_SERVO_USE_DITHER
+
+void IRAM_ATTR ESP8266_ISR_Servo::ditherServos()
+{
+  uint8_t   servoIndex;
+  uint8_t   error;
+  uint16_t  mask = ditherMask;
+
+  // First order sigma-delta: the fraction is accumulated each frame, and one more timer count is output
+  // each time it reaches TIMER_INTERVAL_MICRO. Slewing servos are dithered once at their target
+#if ISR_SERVO_USE_SLEW
+  mask &= ~slewingMask;
+#endif
+
+  for (servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if ( !(mask & (1 << servoIndex)) )
+      continue;
 
-      return servoIndex;
+    error = servo[servoIndex].ditherError + servo[servoIndex].fraction;
+
+    if (error >= TIMER_INTERVAL_MICRO)
+    {
+      servo[servoIndex].count = servo[servoIndex].target + 1;
+      error -= TIMER_INTERVAL_MICRO;
     }
+    else
+      servo[servoIndex].count = servo[servoIndex].target;
+
+    servo[servoIndex].ditherError = error;
   }
+}
 
-  // no free slots found
-  return -1;
+#endif    // ISR_SERVO_USE_DITHER
+
+#if ISR_SERVO_USE_OSCILLATOR
+
+void IRAM_ATTR ESP8266_ISR_Servo::oscillateServos()
+{
+  const int32_t maxPhaseStep = ( (uint64_t) ISR_SERVO_OSCILLATOR_PHASE_RAMP << 32) / 360;
+
+  uint8_t servoIndex;
+  int32_t pulseWidth;
+  int32_t phaseStep;
+
+  for (servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if ( !(oscillatorMask & (1 << servoIndex)) )
+      continue;
+
+    // Parameter changes are ramped, so that the output has no step
+    servo[servoIndex].oscCenter     = rampTo(servo[servoIndex].oscCenter, servo[servoIndex].oscCenterTarget,
+                                             ISR_SERVO_OSCILLATOR_RAMP);
+    servo[servoIndex].oscAmplitude  = rampTo(servo[servoIndex].oscAmplitude, servo[servoIndex].oscAmplitudeTarget,
+                                             ISR_SERVO_OSCILLATOR_RAMP);
+
+    // The phase goes the shortest way round
+    phaseStep = (int32_t) (servo[servoIndex].oscPhaseTarget - servo[servoIndex].oscPhaseOffset);
+
+    if (phaseStep > maxPhaseStep)
+      phaseStep = maxPhaseStep;
+    else if (phaseStep < -maxPhaseStep)
+      phaseStep = -maxPhaseStep;
+
+    servo[servoIndex].oscPhaseOffset += phaseStep;
+
+    pulseWidth = servo[servoIndex].oscCenter + ( ( (int32_t) servo[servoIndex].oscAmplitude
+                 * sine(servo[servoIndex].oscPhase + servo[servoIndex].oscPhaseOffset) ) >> 15 );
+
+    servo[servoIndex].oscPhase += servo[servoIndex].oscIncrement;
+
+    if (pulseWidth < servo[servoIndex].min)
+      pulseWidth = servo[servoIndex].min;
+    else if (pulseWidth > servo[servoIndex].max)
+      pulseWidth = servo[servoIndex].max;
+
+    setTarget(servoIndex, pulseWidth / TIMER_INTERVAL_MICRO, pulseWidth % TIMER_INTERVAL_MICRO);
+  }
+}
+
+int32_t IRAM_ATTR ESP8266_ISR_Servo::sine(const uint32_t phase)
+{
+  uint8_t quadrant  = phase >> 30;
+  uint8_t step      = (phase >> 24) & 0x3F;
+  int32_t weight    = (phase >> 16) & 0xFF;
+  int32_t from, to;
+
+  // Second and fourth quarters mirror the table
+  if (quadrant & 1)
+  {
+    from  = ISR_SERVO_SINE_TABLE[64 - step];
+    to    = ISR_SERVO_SINE_TABLE[63 - step];
+  }
+  else
+  {
+    from  = ISR_SERVO_SINE_TABLE[step];
+    to    = ISR_SERVO_SINE_TABLE[step + 1];
+  }
+
+  from += ( (to - from) * weight) >> 8;
+
+  // Second half is negative
+  return (quadrant & 2) ? -from : from;
+}
+
+#endif    // ISR_SERVO_USE_OSCILLATOR
+
+// find the first available slot in O(1), using allocatedMask
+// return -1 if none found
+int8_t ESP8266_ISR_Servo::findFirstFreeSlot()
+{
+  uint16_t freeMask = ~allocatedMask & ( (1UL << MAX_SERVOS) - 1);
+
+  // all slots are used
+  if (freeMask == 0)
+    return -1;
+
+  ISR_SERVO_LOGDEBUG1("Index =", __builtin_ctz(freeMask));
+
+  return __builtin_ctz(freeMask);
 }
 
 
@@ -166,9 +527,18 @@ int8_t ESP8266_ISR_Servo::setupServo(const uint8_t& pin, const uint16_t& min, co
   servo[servoIndex].min        = min;
   servo[servoIndex].max        = max;
   servo[servoIndex].count      = min / TIMER_INTERVAL_MICRO;
+  servo[servoIndex].target     = servo[servoIndex].count;
+#if ISR_SERVO_USE_SLEW
+  servo[servoIndex].maxStep    = 0;
+#endif
   servo[servoIndex].position   = 0;
   servo[servoIndex].enabled    = true;
 
+  allocatedMask |= (1 << servoIndex);
+
+  memset((void*) &filter[servoIndex], 0, sizeof (servo_filter_t));
+  filter[servoIndex].lastPulseWidth = servo[servoIndex].count * TIMER_INTERVAL_MICRO;
+
   pinMode(pin, OUTPUT);
 
   numServos++;
@@ -176,23 +546,38 @@ int8_t ESP8266_ISR_Servo::setupServo(const uint8_t& pin, const uint16_t& min, co
   ISR_SERVO_LOGDEBUG3("Index =", servoIndex, ", count =", servo[servoIndex].count);
   ISR_SERVO_LOGDEBUG3("min =", servo[servoIndex].min, ", max =", servo[servoIndex].max);
 
-  return servoIndex;
+  return handleOf(servoIndex);
 }
 
 bool ESP8266_ISR_Servo::setPosition(const uint8_t& servoIndex, const uint16_t& position)
 {
-  if (servoIndex >= MAX_SERVOS)
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
     return false;
 
   // Updates interval of existing specified servo
-  if ( servo[servoIndex].enabled && (servo[servoIndex].pin <= ESP8266_MAX_PIN) )
+  if ( servo[slot].enabled && (servo[slot].pin <= ESP8266_MAX_PIN) )
   {
-    servo[servoIndex].position  = position;
-    servo[servoIndex].count     = map(position, 0, 180, servo[servoIndex].min,
-                                      servo[servoIndex].max) / TIMER_INTERVAL_MICRO;
+    // No-op update, skip map() and logging. A position mapped back from a pulse width is truncated, so not exact
+    if (filter[slot].byPosition && (position == servo[slot].position) )
+    {
+      filter[slot].suppressed++;
+
+      return true;
+    }
+
+    uint16_t pulseWidth = map(position, 0, 180, servo[slot].min, servo[slot].max);
+
+    if (!filterUpdate(slot, pulseWidth))
+      return true;
+
+    servo[slot].position  = position;
+    filter[slot].byPosition = true;
+    setWidth(slot, pulseWidth);
 
     ISR_SERVO_LOGERROR1("Idx =", servoIndex);
-    ISR_SERVO_LOGERROR3("cnt =", servo[servoIndex].count, ", pos =", servo[servoIndex].position);
+    ISR_SERVO_LOGERROR3("cnt =", servo[slot].count, ", pos =", servo[slot].position);
 
     return true;
   }
@@ -204,16 +589,18 @@ bool ESP8266_ISR_Servo::setPosition(const uint8_t& servoIndex, const uint16_t& p
 // returns last position in degrees if success, or -1 on wrong servoIndex
 int ESP8266_ISR_Servo::getPosition(const uint8_t& servoIndex)
 {
-  if (servoIndex >= MAX_SERVOS)
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
     return -1;
 
   // Updates interval of existing specified servo
-  if ( servo[servoIndex].enabled && (servo[servoIndex].pin <= ESP8266_MAX_PIN) )
+  if ( servo[slot].enabled && (servo[slot].pin <= ESP8266_MAX_PIN) )
   {
     ISR_SERVO_LOGERROR1("Idx =", servoIndex);
-    ISR_SERVO_LOGERROR3("cnt =", servo[servoIndex].count, ", pos =", servo[servoIndex].position);
+    ISR_SERVO_LOGERROR3("cnt =", servo[slot].count, ", pos =", servo[slot].position);
 
-    return (servo[servoIndex].position);
+    return (servo[slot].position);
   }
 
   // return 0 for non-used numServo or bad pin
@@ -227,22 +614,28 @@ int ESP8266_ISR_Servo::getPosition(const uint8_t& servoIndex)
 // returns true on success or -1 on wrong servoIndex
 bool ESP8266_ISR_Servo::setPulseWidth(const uint8_t& servoIndex, uint16_t& pulseWidth)
 {
-  if (servoIndex >= MAX_SERVOS)
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
     return false;
 
   // Updates interval of existing specified servo
-  if ( servo[servoIndex].enabled && (servo[servoIndex].pin <= ESP8266_MAX_PIN) )
+  if ( servo[slot].enabled && (servo[slot].pin <= ESP8266_MAX_PIN) )
   {
-    if (pulseWidth < servo[servoIndex].min)
-      pulseWidth = servo[servoIndex].min;
-    else if (pulseWidth > servo[servoIndex].max)
-      pulseWidth = servo[servoIndex].max;
+    if (pulseWidth < servo[slot].min)
+      pulseWidth = servo[slot].min;
+    else if (pulseWidth > servo[slot].max)
+      pulseWidth = servo[slot].max;
+
+    if (!filterUpdate(slot, pulseWidth))
+      return true;
 
-    servo[servoIndex].count     = pulseWidth / TIMER_INTERVAL_MICRO;
-    servo[servoIndex].position  = map(pulseWidth, servo[servoIndex].min, servo[servoIndex].max, 0, 180);
+    setWidth(slot, pulseWidth);
+    servo[slot].position  = map(pulseWidth, servo[slot].min, servo[slot].max, 0, 180);
+    filter[slot].byPosition = false;
 
     ISR_SERVO_LOGERROR1("Idx =", servoIndex);
-    ISR_SERVO_LOGERROR3("cnt =", servo[servoIndex].count, ", pos =", servo[servoIndex].position);
+    ISR_SERVO_LOGERROR3("cnt =", servo[slot].count, ", pos =", servo[slot].position);
 
     return true;
   }
@@ -254,16 +647,22 @@ bool ESP8266_ISR_Servo::setPulseWidth(const uint8_t& servoIndex, uint16_t& pulse
 // returns pulseWidth in microsecs (within min/max range) if success, or 0 on wrong servoIndex
 unsigned int ESP8266_ISR_Servo::getPulseWidth(const uint8_t& servoIndex)
 {
-  if (servoIndex >= MAX_SERVOS)
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
     return 0;
 
   // Updates interval of existing specified servo
-  if ( servo[servoIndex].enabled && (servo[servoIndex].pin <= ESP8266_MAX_PIN) )
+  if ( servo[slot].enabled && (servo[slot].pin <= ESP8266_MAX_PIN) )
   {
     ISR_SERVO_LOGERROR1("Idx =", servoIndex);
-    ISR_SERVO_LOGERROR3("cnt =", servo[servoIndex].count, ", pos =", servo[servoIndex].position);
+    ISR_SERVO_LOGERROR3("cnt =", servo[slot].count, ", pos =", servo[slot].position);
+
+    // Average of the dithered pulse widths
+    if (isDithered(slot))
+      return (servo[slot].target * TIMER_INTERVAL_MICRO + servo[slot].fraction);
 
-    return (servo[servoIndex].count * TIMER_INTERVAL_MICRO );
+    return (servo[slot].count * TIMER_INTERVAL_MICRO );
   }
 
   // return 0 for non-used numServo or bad pin
@@ -271,119 +670,999 @@ unsigned int ESP8266_ISR_Servo::getPulseWidth(const uint8_t& servoIndex)
 }
 
 
-void ESP8266_ISR_Servo::deleteServo(const uint8_t& servoIndex)
-{
-  if ( (numServos == 0) || (servoIndex >= MAX_SERVOS) )
-  {
-    return;
-  }
+#if ISR_SERVO_USE_SLEW
 
-  // don't decrease the number of servos if the specified slot is already empty
-  if (servo[servoIndex].enabled)
-  {
-    memset((void*) &servo[servoIndex], 0, sizeof (servo_t));
+bool ESP8266_ISR_Servo::setSlewRate(const uint8_t& servoIndex, const uint16_t& maxStep)
+{
+  int8_t slot = slotOf(servoIndex);
 
-    servo[servoIndex].enabled   = false;
-    servo[servoIndex].position  = 0;
-    servo[servoIndex].count     = 0;
-    // Intentional bad pin, good only from 0-16 for Digital, A0=17
-    servo[servoIndex].pin       = ESP8266_WRONG_PIN;
+  if (slot < 0)
+    return false;
 
-    // update number of servos
-    numServos--;
-  }
-}
+  noInterrupts();
 
-bool ESP8266_ISR_Servo::isEnabled(const uint8_t& servoIndex)
-{
-  if (servoIndex >= MAX_SERVOS)
-    return false;
+  // At least one timer count per frame, or the servo would never move
+  if ( (maxStep != 0) && (maxStep < TIMER_INTERVAL_MICRO) )
+    servo[slot].maxStep = 1;
+  else
+    servo[slot].maxStep = maxStep / TIMER_INTERVAL_MICRO;
 
-  if (servo[servoIndex].pin > ESP8266_MAX_PIN)
+  if (servo[slot].maxStep == 0)
   {
-    // Disable if something wrong
-    servo[servoIndex].pin     = ESP8266_WRONG_PIN;
-    servo[servoIndex].enabled = false;
-    return false;
+    // No more limit, jump to target
+    servo[slot].count = servo[slot].target;
+    slewingMask &= ~(1 << slot);
+    movingMask  &= ~(1 << slot);
   }
 
-  return servo[servoIndex].enabled;
+  interrupts();
+
+  return true;
+}
+
+void ESP8266_ISR_Servo::setMaxMovingServos(const uint8_t& maxMoving)
+{
+  maxMovingServos = maxMoving;
 }
 
+#endif    // ISR_SERVO_USE_SLEW
 
-bool ESP8266_ISR_Servo::enable(const uint8_t& servoIndex)
+bool ESP8266_ISR_Servo::isMoving(const uint8_t& servoIndex)
 {
-  if (servoIndex >= MAX_SERVOS)
-    return false;
+  int8_t slot = slotOf(servoIndex);
 
-  if (servo[servoIndex].pin > ESP8266_MAX_PIN)
-  {
-    // Disable if something wrong
-    servo[servoIndex].pin     = ESP8266_WRONG_PIN;
-    servo[servoIndex].enabled = false;
+  if (slot < 0)
     return false;
-  }
 
-  // Bug fix. See "Fixed count >= min comparison for servo enable."
-  // (https://github.com/khoih-prog/ESP32_ISR_Servo/pull/1)
-  if ( servo[servoIndex].count >= servo[servoIndex].min / TIMER_INTERVAL_MICRO )
-    servo[servoIndex].enabled = true;
+#if ISR_SERVO_USE_SLEW
 
-  return true;
-}
+  if (slewingMask & (1 << slot))
+    return true;
 
+#endif
 
-bool ESP8266_ISR_Servo::disable(const uint8_t& servoIndex)
-{
-  if (servoIndex >= MAX_SERVOS)
-    return false;
+#if ISR_SERVO_USE_GROUPS
 
-  if (servo[servoIndex].pin > ESP8266_MAX_PIN)
-    servo[servoIndex].pin     = ESP8266_WRONG_PIN;
+  if (pendingMask & (1 << slot))
+    return true;
 
-  servo[servoIndex].enabled = false;
+#endif
 
-  return true;
+  return false;
 }
 
-void ESP8266_ISR_Servo::enableAll()
+#if ISR_SERVO_USE_DITHER
+
+bool ESP8266_ISR_Servo::setDithering(const uint8_t& servoIndex, const bool& dithering)
 {
-  // Enable all servos with a enabled and count != 0 (has PWM) and good pin
-  for (int8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  noInterrupts();
+
+  if (dithering)
   {
-    // Bug fix. See "Fixed count >= min comparison for servo enable."
-    // (https://github.com/khoih-prog/ESP32_ISR_Servo/pull/1)
-    if ( (servo[servoIndex].count >= servo[servoIndex].min / TIMER_INTERVAL_MICRO ) && !servo[servoIndex].enabled
-         && (servo[servoIndex].pin <= ESP8266_MAX_PIN) )
-    {
-      servo[servoIndex].enabled = true;
-    }
+    ditherMask |= (1 << slot);
   }
-}
-
-void ESP8266_ISR_Servo::disableAll()
-{
-  // Disable all servos
-  for (int8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  else
   {
-    servo[servoIndex].enabled = false;
+    ditherMask &= ~(1 << slot);
+
+    // Back to the truncated pulse width, unless still slewing towards it
+#if ISR_SERVO_USE_SLEW
+    if ( !(slewingMask & (1 << slot)) )
+#endif
+      servo[slot].count = servo[slot].target;
   }
-}
 
-bool ESP8266_ISR_Servo::toggle(const uint8_t& servoIndex)
-{
-  if (servoIndex >= MAX_SERVOS)
-    return false;
+  servo[slot].ditherError = 0;
 
-  servo[servoIndex].enabled = !servo[servoIndex].enabled;
+  interrupts();
+
+  // Next update is applied even if it only changes the fraction
+  filter[slot].lastPulseWidth = servo[slot].target * TIMER_INTERVAL_MICRO;
 
   return true;
 }
 
-
-int8_t ESP8266_ISR_Servo::getNumServos()
+bool ESP8266_ISR_Servo::isDithering(const uint8_t& servoIndex)
 {
-  return numServos;
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  return (ditherMask & (1 << slot));
+}
+
+#endif    // ISR_SERVO_USE_DITHER
+
+#if ISR_SERVO_USE_OSCILLATOR
+
+bool ESP8266_ISR_Servo::setOscillator(const uint8_t& servoIndex, const uint16_t& center, const uint16_t& amplitude,
+                                      const uint16_t& frequency, const uint16_t& phase)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  // Above half the frame rate, the samples would alias
+  if ( (slot < 0) || ( (uint32_t) frequency * REFRESH_INTERVAL > 500000000UL) )
+    return false;
+
+  if ( !servo[slot].enabled || (servo[slot].pin > ESP8266_MAX_PIN) )
+    return false;
+
+  uint32_t increment  = oscillatorIncrement(frequency);
+  uint32_t offset     = ( (uint64_t) (phase % 360) << 32) / 360;
+
+  // All parameters change in the same frame. The accumulator of an oscillating servo is kept, for phase continuity
+  noInterrupts();
+
+  if ( !(oscillatorMask & (1 << slot)) )
+  {
+    // Start from the current pulse width, then ramp to the requested center and amplitude
+    servo[slot].oscPhase        = 0;
+    servo[slot].oscCenter       = servo[slot].target * TIMER_INTERVAL_MICRO + servo[slot].fraction;
+    servo[slot].oscAmplitude    = 0;
+    servo[slot].oscPhaseOffset  = offset;
+  }
+
+  servo[slot].oscCenterTarget     = center;
+  servo[slot].oscAmplitudeTarget  = amplitude;
+  servo[slot].oscIncrement        = increment;
+  servo[slot].oscPhaseTarget      = offset;
+
+  oscillatorMask |= (1 << slot);
+
+#if ISR_SERVO_USE_GROUPS
+  pendingMask    &= ~(1 << slot);
+#endif
+
+#if ISR_SERVO_USE_SYNC
+  scheduledMask  &= ~(1 << slot);
+#endif
+
+  interrupts();
+
+  ISR_SERVO_LOGDEBUG3("Oscillator Idx =", servoIndex, ", increment =", increment);
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::setOscillatorFrequency(const ESP8266_ISR_Servo_Group& group, const uint16_t& frequency)
+{
+  uint16_t mask = group.getMask();
+
+  if ( ( (uint32_t) frequency * REFRESH_INTERVAL > 500000000UL ) || !isGroupValid(group) )
+    return false;
+
+  uint32_t increment = oscillatorIncrement(frequency);
+
+  noInterrupts();
+
+  // Members not oscillating are left alone
+  mask &= oscillatorMask;
+
+  for (uint8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if (mask & (1 << servoIndex))
+      servo[servoIndex].oscIncrement = increment;
+  }
+
+  interrupts();
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::syncOscillators(const ESP8266_ISR_Servo_Group& group)
+{
+  uint16_t mask = group.getMask();
+
+  if (!isGroupValid(group))
+    return false;
+
+  noInterrupts();
+
+  // Members not oscillating are left alone
+  mask &= oscillatorMask;
+
+  for (uint8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    // Same output now, the difference to the aligned phase is then ramped out by oscillateServos()
+    if (mask & (1 << servoIndex))
+    {
+      servo[servoIndex].oscPhaseOffset += servo[servoIndex].oscPhase;
+      servo[servoIndex].oscPhase        = 0;
+    }
+  }
+
+  interrupts();
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::stopOscillator(const uint8_t& servoIndex)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  noInterrupts();
+
+  oscillatorMask &= ~(1 << slot);
+
+  interrupts();
+
+  // Hold the last target, as if set by setPulseWidth()
+  uint16_t pulseWidth = servo[slot].target * TIMER_INTERVAL_MICRO + servo[slot].fraction;
+
+  servo[slot].position  = map(pulseWidth, servo[slot].min, servo[slot].max, 0, 180);
+  filter[slot].byPosition     = false;
+  filter[slot].lastPulseWidth = isDithered(slot) ? pulseWidth : pulseWidth - pulseWidth % TIMER_INTERVAL_MICRO;
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::isOscillating(const uint8_t& servoIndex)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  return (oscillatorMask & (1 << slot));
+}
+
+#endif    // ISR_SERVO_USE_OSCILLATOR
+
+// returns true if all members of group are still set up, i.e. not deleted since added to group
+bool ESP8266_ISR_Servo::isGroupValid(const ESP8266_ISR_Servo_Group& group)
+{
+  uint16_t mask = group.getMask();
+
+  for (uint8_t servoIndex = 0; mask; servoIndex++, mask >>= 1)
+  {
+    // Stale members, whose slot was freed or set up again, are rejected by slotOf()
+    if ( (mask & 1) && (slotOf(group.getServoIndex(servoIndex)) < 0) )
+    {
+      ISR_SERVO_LOGERROR1("Group member not valid, Idx =", servoIndex);
+
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// returns true if all members of group are valid, enabled and have good pin
+bool ESP8266_ISR_Servo::isGroupReady(const ESP8266_ISR_Servo_Group& group)
+{
+  uint16_t mask = group.getMask();
+
+  if (!isGroupValid(group))
+    return false;
+
+  for (uint8_t servoIndex = 0; mask; servoIndex++, mask >>= 1)
+  {
+    if ( (mask & 1) && !( servo[servoIndex].enabled && (servo[servoIndex].pin <= ESP8266_MAX_PIN) ) )
+    {
+      ISR_SERVO_LOGERROR1("Group not ready, Idx =", servoIndex);
+
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// returns true if pulseWidth must be applied, false if suppressed by change detection or deadband
+bool ESP8266_ISR_Servo::filterUpdate(const uint8_t& servoIndex, const uint16_t& pulseWidth)
+{
+  uint16_t newWidth = pulseWidth;
+  bool     replace  = false;
+
+  // Without dithering, only the timer count matters
+  if (!isDithered(servoIndex))
+    newWidth -= newWidth % TIMER_INTERVAL_MICRO;
+
+#if ISR_SERVO_USE_SYNC
+
+  // A pending scheduled move is replaced by any update. Once applied by run(), its pulse width is the reference
+  if (filter[servoIndex].scheduled)
+  {
+    filter[servoIndex].scheduled = false;
+
+    if (scheduledMask & (1 << servoIndex))
+      replace = true;
+    else
+      filter[servoIndex].lastPulseWidth = servo[servoIndex].target * TIMER_INTERVAL_MICRO
+                                          + (isDithered(servoIndex) ? servo[servoIndex].fraction : 0);
+  }
+
+#endif
+
+  uint16_t delta = (newWidth > filter[servoIndex].lastPulseWidth) ? (newWidth - filter[servoIndex].lastPulseWidth) :
+                   (filter[servoIndex].lastPulseWidth - newWidth);
+
+  if ( !replace && ( (delta == 0) || (delta < filter[servoIndex].deadband) ) )
+  {
+    filter[servoIndex].suppressed++;
+
+    return false;
+  }
+
+  filter[servoIndex].lastPulseWidth = newWidth;
+  filter[servoIndex].applied++;
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::setDeadband(const uint8_t& servoIndex, const uint16_t& deadband)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  filter[slot].deadband = deadband;
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::setDeadbandDegrees(const uint8_t& servoIndex, const uint16_t& degrees)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  filter[slot].deadband = ( (unsigned long) degrees * (servo[slot].max - servo[slot].min) ) / 180;
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::getUpdateStats(const uint8_t& servoIndex, unsigned long& applied, unsigned long& suppressed)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  applied     = filter[slot].applied;
+  suppressed  = filter[slot].suppressed;
+
+  return true;
+}
+
+void ESP8266_ISR_Servo::resetUpdateStats(const uint8_t& servoIndex)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return;
+
+  filter[slot].applied     = 0;
+  filter[slot].suppressed  = 0;
 }
 
+// set pulse width of a single servo immediately, dropping any group update or scheduled move still pending for it
+void ESP8266_ISR_Servo::setWidth(const uint8_t& servoIndex, const uint16_t& pulseWidth)
+{
+  noInterrupts();
+
+  setTarget(servoIndex, pulseWidth / TIMER_INTERVAL_MICRO, pulseWidth % TIMER_INTERVAL_MICRO);
+
+#if ISR_SERVO_USE_GROUPS
+  pendingMask &= ~(1 << servoIndex);
+#endif
+
+#if ISR_SERVO_USE_SYNC
+  scheduledMask &= ~(1 << servoIndex);
+#endif
+
+  interrupts();
+}
+
+#if ISR_SERVO_USE_GROUPS
+
+// stage pulse width for all servos in mask, to be applied by run() at the next frame start, replacing scheduled moves
+void ESP8266_ISR_Servo::publishWidths(const uint16_t& mask, const uint16_t pulseWidth[])
+{
+  // Block the ISR so that it can't see a partially written group
+  noInterrupts();
+
+  for (uint8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if (mask & (1 << servoIndex))
+    {
+      servo[servoIndex].pendingCount    = pulseWidth[servoIndex] / TIMER_INTERVAL_MICRO;
+      servo[servoIndex].pendingFraction = pulseWidth[servoIndex] % TIMER_INTERVAL_MICRO;
+    }
+  }
+
+  pendingMask |= mask;
+
+#if ISR_SERVO_USE_SYNC
+  scheduledMask &= ~mask;
+#endif
+
+  interrupts();
+}
+
+bool ESP8266_ISR_Servo::setPositions(const ESP8266_ISR_Servo_Group& group, const uint16_t positions[])
+{
+  uint16_t      mask = group.getMask();
+  uint16_t      newWidth[MAX_SERVOS];
+  uint8_t       member = 0;
+
+  if ( (numServos <= 0) || !isGroupReady(group) )
+    return false;
+
+  for (uint8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if (mask & (1 << servoIndex))
+    {
+      newWidth[servoIndex] = map(positions[member], 0, 180, servo[servoIndex].min, servo[servoIndex].max);
+
+      // Drop members with no-op update from the published mask, counted as suppressed as by setPosition()
+      if (filter[servoIndex].byPosition && (positions[member] == servo[servoIndex].position) )
+      {
+        filter[servoIndex].suppressed++;
+        mask &= ~(1 << servoIndex);
+      }
+      else if (filterUpdate(servoIndex, newWidth[servoIndex]))
+      {
+        servo[servoIndex].position      = positions[member];
+        filter[servoIndex].byPosition   = true;
+      }
+      else
+        mask &= ~(1 << servoIndex);
+
+      member++;
+    }
+  }
+
+  if (mask)
+    publishWidths(mask, newWidth);
+
+  ISR_SERVO_LOGDEBUG3("Group =", mask, ", members =", member);
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::setPulseWidths(const ESP8266_ISR_Servo_Group& group, const uint16_t pulseWidths[])
+{
+  uint16_t      mask = group.getMask();
+  uint16_t      newWidth[MAX_SERVOS];
+  uint8_t       member = 0;
+  uint16_t      pulseWidth;
+
+  if ( (numServos <= 0) || !isGroupReady(group) )
+    return false;
+
+  for (uint8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if (mask & (1 << servoIndex))
+    {
+      pulseWidth = pulseWidths[member++];
+
+      if (pulseWidth < servo[servoIndex].min)
+        pulseWidth = servo[servoIndex].min;
+      else if (pulseWidth > servo[servoIndex].max)
+        pulseWidth = servo[servoIndex].max;
+
+      newWidth[servoIndex] = pulseWidth;
+
+      // Drop members with no-op update from the published mask
+      if (filterUpdate(servoIndex, newWidth[servoIndex]))
+      {
+        servo[servoIndex].position      = map(pulseWidth, servo[servoIndex].min, servo[servoIndex].max, 0, 180);
+        filter[servoIndex].byPosition   = false;
+      }
+      else
+        mask &= ~(1 << servoIndex);
+    }
+  }
+
+  if (mask)
+    publishWidths(mask, newWidth);
+
+  ISR_SERVO_LOGDEBUG3("Group =", mask, ", members =", member);
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::moveTo(const ESP8266_ISR_Servo_Group& group, const uint16_t& position)
+{
+  uint16_t positions[MAX_SERVOS];
+
+  for (uint8_t member = 0; member < MAX_SERVOS; member++)
+    positions[member] = position;
+
+  return setPositions(group, positions);
+}
+
+#endif    // ISR_SERVO_USE_GROUPS
+
+bool ESP8266_ISR_Servo::enable(const ESP8266_ISR_Servo_Group& group)
+{
+  uint16_t mask = group.getMask();
+
+  if ( (numServos <= 0) || !isGroupValid(group) )
+    return false;
+
+  for (uint8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if ( (mask & (1 << servoIndex)) && (servo[servoIndex].pin > ESP8266_MAX_PIN) )
+      return false;
+  }
+
+  // Block the ISR so that all members start in the same frame
+  noInterrupts();
+
+  for (uint8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    // Same rule as enable(servoIndex): only servos having a valid count
+    if ( (mask & (1 << servoIndex)) && (servo[servoIndex].count >= servo[servoIndex].min / TIMER_INTERVAL_MICRO) )
+      servo[servoIndex].enabled = true;
+  }
+
+  interrupts();
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::disable(const ESP8266_ISR_Servo_Group& group)
+{
+  uint16_t mask = group.getMask();
+
+  if ( (numServos <= 0) || !isGroupValid(group) )
+    return false;
+
+  // Block the ISR so that all members stop in the same frame
+  noInterrupts();
+
+  for (uint8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    if (mask & (1 << servoIndex))
+    {
+      servo[servoIndex].enabled = false;
+
+      // run() won't output the falling edge of a pulse in progress any more
+      if (servo[servoIndex].pin <= ESP8266_MAX_PIN)
+        ISR_SERVO_WRITE_PIN(servo[servoIndex].pin, LOW);
+    }
+  }
+
+  interrupts();
+
+  return true;
+}
+
+void ESP8266_ISR_Servo::deleteServo(const uint8_t& servoIndex)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  // don't decrease the number of servos if the specified slot is already free
+  if ( (numServos <= 0) || (slot < 0) )
+  {
+    return;
+  }
+
+  noInterrupts();
+
+  servo[slot].enabled = false;
+
+#if ISR_SERVO_USE_GROUPS
+  pendingMask &= ~(1 << slot);
+#endif
+
+#if ISR_SERVO_USE_SLEW
+  slewingMask &= ~(1 << slot);
+  movingMask  &= ~(1 << slot);
+#endif
+
+#if ISR_SERVO_USE_SYNC
+  scheduledMask &= ~(1 << slot);
+#endif
+
+#if ISR_SERVO_USE_DITHER
+  ditherMask  &= ~(1 << slot);
+#endif
+
+#if ISR_SERVO_USE_OSCILLATOR
+  oscillatorMask &= ~(1 << slot);
+#endif
+
+  interrupts();
+
+  memset((void*) &servo[slot], 0, sizeof (servo_t));
+
+  servo[slot].enabled   = false;
+  servo[slot].position  = 0;
+  servo[slot].count     = 0;
+  // Intentional bad pin, good only from 0-16 for Digital, A0=17
+  servo[slot].pin       = ESP8266_WRONG_PIN;
+
+  // free the slot, and invalidate the handles still pointing to it
+  allocatedMask     &= ~(1 << slot);
+  generation[slot]  = (generation[slot] + 1) & ISR_SERVO_GENERATION_MASK;
+
+  // update number of servos
+  numServos--;
+}
+
+bool ESP8266_ISR_Servo::isEnabled(const uint8_t& servoIndex)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  if (servo[slot].pin > ESP8266_MAX_PIN)
+  {
+    // Disable if something wrong
+    servo[slot].pin     = ESP8266_WRONG_PIN;
+    servo[slot].enabled = false;
+    return false;
+  }
+
+  return servo[slot].enabled;
+}
+
+
+bool ESP8266_ISR_Servo::enable(const uint8_t& servoIndex)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  if (servo[slot].pin > ESP8266_MAX_PIN)
+  {
+    // Disable if something wrong
+    servo[slot].pin     = ESP8266_WRONG_PIN;
+    servo[slot].enabled = false;
+    return false;
+  }
+
+  // Bug fix. See "Fixed count >= min comparison for servo enable."
+  // (https://github.com/khoih-prog/ESP32_ISR_Servo/pull/1)
+  if ( servo[slot].count >= servo[slot].min / TIMER_INTERVAL_MICRO )
+    servo[slot].enabled = true;
+
+  return true;
+}
+
+
+bool ESP8266_ISR_Servo::disable(const uint8_t& servoIndex)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  if (servo[slot].pin > ESP8266_MAX_PIN)
+    servo[slot].pin     = ESP8266_WRONG_PIN;
+
+  servo[slot].enabled = false;
+
+  return true;
+}
+
+void ESP8266_ISR_Servo::enableAll()
+{
+  // Enable all servos with a enabled and count != 0 (has PWM) and good pin
+  for (int8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    // Bug fix. See "Fixed count >= min comparison for servo enable."
+    // (https://github.com/khoih-prog/ESP32_ISR_Servo/pull/1)
+    if ( (allocatedMask & (1 << servoIndex)) && !servo[servoIndex].enabled
+         && (servo[servoIndex].count >= servo[servoIndex].min / TIMER_INTERVAL_MICRO )
+         && (servo[servoIndex].pin <= ESP8266_MAX_PIN) )
+    {
+      servo[servoIndex].enabled = true;
+    }
+  }
+}
+
+void ESP8266_ISR_Servo::disableAll()
+{
+  // Disable all servos
+  for (int8_t servoIndex = 0; servoIndex < MAX_SERVOS; servoIndex++)
+  {
+    servo[servoIndex].enabled = false;
+  }
+}
+
+bool ESP8266_ISR_Servo::toggle(const uint8_t& servoIndex)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if (slot < 0)
+    return false;
+
+  servo[slot].enabled = !servo[slot].enabled;
+
+  return true;
+}
+
+
+int8_t ESP8266_ISR_Servo::getNumServos()
+{
+  return numServos;
+}
+
+void ESP8266_ISR_Servo::snapshot(ServoSnapshot& snap)
+{
+  uint32_t seq;
+
+  do
+  {
+    seq = updateSeq;
+
+    snap.frame          = frameCount;
+    snap.allocatedMask  = allocatedMask;
+    snap.enabledMask    = 0;
+
+    for (uint8_t slot = 0; slot < MAX_SERVOS; slot++)
+    {
+      if (servo[slot].enabled)
+        snap.enabledMask |= (1 << slot);
+
+      snap.position[slot]   = servo[slot].position;
+      snap.pulseWidth[slot] = servo[slot].count * TIMER_INTERVAL_MICRO;
+    }
+  } while ( (seq & 1) || (seq != updateSeq) );
+}
+
+#if ISR_SERVO_USE_SYNC
+
+void ESP8266_ISR_Servo::syncToReference(const uint64_t& refTime, const int32_t& offset)
+{
+  const int32_t frameTicks = REFRESH_INTERVAL / TIMER_INTERVAL_MICRO;
+
+  // 64-bit, so that the frame grid has no jump. The frame number wraps after 2^32 frames, consistently on all boards
+  uint64_t  time        = refTime + offset;
+  uint32_t  refFrame    = (uint32_t) (time / REFRESH_INTERVAL);
+  int32_t   refTick     = (time % REFRESH_INTERVAL) / TIMER_INTERVAL_MICRO;
+  uint32_t  localFrame;
+  int32_t   localTick;
+  int32_t   error;
+
+  if (numServos < 0)
+    return;
+
+  noInterrupts();
+
+  // timerCount is the next tick to run, 1 at the frame start. Pending trim is dropped, the new error replaces it
+  localFrame  = frameCount + frameOffset;
+  localTick   = timerCount - 1;
+
+  // Ticks the reference is ahead of us, reduced to less than half a frame. The frame difference is aligned at once
+  error = refTick - localTick;
+
+  if (error >= frameTicks / 2)
+  {
+    error -= frameTicks;
+    refFrame++;
+  }
+  else if (error < -frameTicks / 2)
+  {
+    error += frameTicks;
+    refFrame--;
+  }
+
+  frameOffset += (int32_t) (refFrame - localFrame);
+  phaseError  = error;
+
+  interrupts();
+
+  ISR_SERVO_LOGDEBUG3("Sync frame =", refFrame, ", phase error =", error * TIMER_INTERVAL_MICRO);
+}
+
+void ESP8266_ISR_Servo::setMaxFrameTrim(const uint16_t& maxTrim)
+{
+  // At least one timer count, or the phase would never be corrected
+  maxFrameTrim = (maxTrim < TIMER_INTERVAL_MICRO) ? 1 : maxTrim / TIMER_INTERVAL_MICRO;
+}
+
+int32_t ESP8266_ISR_Servo::getPhaseError()
+{
+  return phaseError * TIMER_INTERVAL_MICRO;
+}
+
+// stage a scheduled pulse width and position, applied by run() at the start of reference frame atFrame
+bool ESP8266_ISR_Servo::scheduleWidth(const uint8_t& slot, const uint16_t& pulseWidth, const uint16_t& position,
+                                      const uint32_t& atFrame)
+{
+  noInterrupts();
+
+  servo[slot].scheduledCount    = pulseWidth / TIMER_INTERVAL_MICRO;
+  servo[slot].scheduledFraction = pulseWidth % TIMER_INTERVAL_MICRO;
+  servo[slot].scheduledPosition = position;
+  servo[slot].scheduledFrame    = atFrame;
+  scheduledMask |= (1 << slot);
+
+  interrupts();
+
+  // position and lastPulseWidth still describe the current pulse width, until run() applies the move
+  filter[slot].scheduled  = true;
+  filter[slot].byPosition = false;
+
+  return true;
+}
+
+bool ESP8266_ISR_Servo::schedulePosition(const uint8_t& servoIndex, const uint16_t& position, const uint32_t& atFrame)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if ( (slot < 0) || !servo[slot].enabled || (servo[slot].pin > ESP8266_MAX_PIN) )
+    return false;
+
+  return scheduleWidth(slot, map(position, 0, 180, servo[slot].min, servo[slot].max), position, atFrame);
+}
+
+bool ESP8266_ISR_Servo::schedulePulseWidth(const uint8_t& servoIndex, uint16_t& pulseWidth, const uint32_t& atFrame)
+{
+  int8_t slot = slotOf(servoIndex);
+
+  if ( (slot < 0) || !servo[slot].enabled || (servo[slot].pin > ESP8266_MAX_PIN) )
+    return false;
+
+  if (pulseWidth < servo[slot].min)
+    pulseWidth = servo[slot].min;
+  else if (pulseWidth > servo[slot].max)
+    pulseWidth = servo[slot].max;
+
+  return scheduleWidth(slot, pulseWidth, map(pulseWidth, servo[slot].min, servo[slot].max, 0, 180), atFrame);
+}
+
+#endif    // ISR_SERVO_USE_SYNC
+
+#if ISR_SERVO_TRACE
+
+void ESP8266_ISR_Servo::startTrace(const bool& traceISR, const uint16_t& minISRDuration)
+{
+  noInterrupts();
+
+  traceCount        = 0;
+  this->traceISR    = traceISR;
+  traceISRMinCycles = (uint32_t) minISRDuration * ESP.getCpuFreqMHz();
+  traceActive       = true;
+
+  interrupts();
+}
+
+void ESP8266_ISR_Servo::stopTrace()
+{
+  traceActive = false;
+}
+
+bool ESP8266_ISR_Servo::isTraceDone()
+{
+  return !traceActive;
+}
+
+void ESP8266_ISR_Servo::dumpTraceVCD(Print& output)
+{
+  uint16_t  numEvents = traceActive ? 0 : traceCount;
+  uint32_t  cpuFreqMHz = ESP.getCpuFreqMHz();
+  uint8_t   id;
+
+  // VCD identifiers are printable chars, '!' for slot 0, '!' + ISR_SERVO_TRACE_ISR_ID for run()
+  output.println(F("$timescale 1ns $end"));
+  output.println(F("$scope module ISR_Servo $end"));
+
+  for (id = 0; id <= ISR_SERVO_TRACE_ISR_ID; id++)
+  {
+    output.print(F("$var wire 1 "));
+    output.print((char) ('!' + id));
+
+    if (id == ISR_SERVO_TRACE_ISR_ID)
+    {
+      output.println(F(" run $end"));
+    }
+    else
+    {
+      output.print(F(" servo"));
+      output.print(id);
+      output.println(F(" $end"));
+    }
+  }
+
+  output.println(F("$upscope $end"));
+  output.println(F("$enddefinitions $end"));
+  output.println(F("#0"));
+  output.println(F("$dumpvars"));
+
+  for (id = 0; id <= ISR_SERVO_TRACE_ISR_ID; id++)
+  {
+    output.print('x');
+    output.println((char) ('!' + id));
+  }
+
+  output.println(F("$end"));
+
+  for (uint16_t i = 0; i < numEvents; i++)
+  {
+    // Times are relative to the first event. Unsigned subtraction handles the cycle counter wrap
+    output.print('#');
+    output.println( (uint32_t) ( (uint64_t) (traceBuffer[i].cycle - traceBuffer[0].cycle) * 1000 / cpuFreqMHz ) );
+    output.print(traceBuffer[i].level ? '1' : '0');
+    output.println((char) ('!' + traceBuffer[i].id));
+  }
+}
+
+void ESP8266_ISR_Servo::printTraceStats(Print& output)
+{
+  uint16_t  numEvents = traceActive ? 0 : traceCount;
+  float     cpuFreqMHz = ESP.getCpuFreqMHz();
+
+  for (uint8_t slot = 0; slot < MAX_SERVOS; slot++)
+  {
+    uint32_t  lastRise = 0;
+    bool      hasRise = false;
+    uint32_t  width, period;
+    uint32_t  minWidth = UINT32_MAX, maxWidth = 0, minPeriod = UINT32_MAX, maxPeriod = 0;
+    uint64_t  sumWidth = 0, sumPeriod = 0;
+    uint16_t  numWidths = 0, numPeriods = 0;
+
+    for (uint16_t i = 0; i < numEvents; i++)
+    {
+      if (traceBuffer[i].id != slot)
+        continue;
+
+      if (traceBuffer[i].level)
+      {
+        if (hasRise)
+        {
+          period = traceBuffer[i].cycle - lastRise;
+          minPeriod = min(minPeriod, period);
+          maxPeriod = max(maxPeriod, period);
+          sumPeriod += period;
+          numPeriods++;
+        }
+
+        lastRise  = traceBuffer[i].cycle;
+        hasRise   = true;
+      }
+      else if (hasRise)
+      {
+        width = traceBuffer[i].cycle - lastRise;
+        minWidth = min(minWidth, width);
+        maxWidth = max(maxWidth, width);
+        sumWidth += width;
+        numWidths++;
+      }
+    }
+
+    if (numWidths == 0)
+      continue;
+
+    output.print(F("Slot "));
+    output.print(slot);
+    output.print(F(": width avg = "));
+    output.print(sumWidth / numWidths / cpuFreqMHz);
+    output.print(F(", min = "));
+    output.print(minWidth / cpuFreqMHz);
+    output.print(F(", max = "));
+    output.print(maxWidth / cpuFreqMHz);
+
+    if (numPeriods)
+    {
+      output.print(F(", period avg = "));
+      output.print(sumPeriod / numPeriods / cpuFreqMHz);
+      output.print(F(", jitter = "));
+      output.print( (maxPeriod - minPeriod) / cpuFreqMHz);
+    }
+
+    output.println();
+  }
+}
+
+#endif    // ISR_SERVO_TRACE
+
 #endif    // ESP8266_ISR_SERVO_IMPL_H
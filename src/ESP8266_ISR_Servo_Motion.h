@@ -0,0 +1,347 @@
+/****************************************************************************************************************************
+  ESP8266_ISR_Servo_Motion.h
+  For ESP8266 boards
+  Written by Khoi Hoang
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP8266_ISR_Servo
+  Licensed under MIT license
+
+  Streaming playback of motion files (e.g. from LittleFS) to an ESP8266_ISR_Servo, one file frame per servo frame.
+  The file is read in small chunks into 2 buffers, from loop() only, so the ISR never waits for the filesystem.
+  Use utils/motion_encoder.py to create motion files from CSV.
+
+  Motion file format, little endian :
+
+  Header (12 bytes)
+    char[4]   "ISM1"
+    uint8_t   number of channels, 1-16
+    uint8_t   reserved, 0
+    uint16_t  frame period in microsecs, must be REFRESH_INTERVAL
+    uint32_t  number of frames
+
+  Each frame
+    uint16_t  mask of the channels with a new pulse width in this frame, 0 to hold all of them
+    then for each channel in mask, in ascending order
+      int8_t    pulse width change in microsecs, -127 to 127
+      or -128 followed by uint16_t new pulse width in microsecs
+
+  Pulse widths start at 0 (channel not driven), so the first change of a channel must be a full pulse width.
+
+  Version: 1.3.0
+
+  Version Modified By   Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang      04/12/2019 Initial coding
+  1.0.1   K Hoang      05/12/2019 Add more features getPosition and getPulseWidth. Optimize.
+  1.0.2   K Hoang      20/12/2019 Add more Blynk examples.Change example names to avoid duplication.
+  1.1.0   K Hoang      03/01/2021 Fix bug. Add TOC and Version String.
+  1.2.0   K Hoang      18/05/2021 Update to match new ESP8266 core v3.0.0
+  1.3.0   K Hoang      28/02/2022 Convert to `h-only` style. Optimize code by using passing by `reference`
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef ESP8266_ISR_SERVO_MOTION_H
+#define ESP8266_ISR_SERVO_MOTION_H
+
+#include "ESP8266_ISR_Servo.hpp"
+
+// Size of each of the 2 read buffers, in bytes
+#ifndef ISR_SERVO_MOTION_CHUNK_SIZE
+  #define ISR_SERVO_MOTION_CHUNK_SIZE       256
+#endif
+
+#define ISR_SERVO_MOTION_HEADER_SIZE        12
+
+// mask + 16 channels * (escape + uint16_t)
+#define ISR_SERVO_MOTION_MAX_FRAME_SIZE     (2 + 16 * 3)
+
+#define ISR_SERVO_MOTION_ABSOLUTE           -128
+
+#if (ISR_SERVO_MOTION_CHUNK_SIZE < ISR_SERVO_MOTION_MAX_FRAME_SIZE)
+  #error ISR_SERVO_MOTION_CHUNK_SIZE must hold at least one frame
+#endif
+
+#if !ISR_SERVO_USE_GROUPS
+  #error ESP8266_ISR_Servo_Motion publishes through setPulseWidths(), set ISR_SERVO_USE_GROUPS to 1
+#endif
+
+class ESP8266_ISR_Servo_Motion
+{
+  public:
+
+    // servoIndex[channel] is the servo driven by the file channel, as returned by setupServo()
+    // servoIndex must stay valid while playing
+    ESP8266_ISR_Servo_Motion(ESP8266_ISR_Servo& controller, const int8_t servoIndex[], const uint8_t& numServos)
+      : controller(controller), servoIndex(servoIndex), numServos(numServos), stream(NULL), playing(false)
+    {
+    }
+
+    // Check the header and fill both buffers, then start playing at the next servo frame
+    // returns false on bad header, or if the file has more channels than servos
+    bool begin(Stream& stream)
+    {
+      uint8_t header[ISR_SERVO_MOTION_HEADER_SIZE];
+
+      playing = false;
+
+      if ( stream.readBytes((char*) header, sizeof(header)) != sizeof(header) )
+        return false;
+
+      if ( (memcmp(header, "ISM1", 4) != 0) || (header[4] == 0) || (header[4] > numServos) || (header[4] > 16)
+           || ( (header[6] | (header[7] << 8)) != REFRESH_INTERVAL) )
+      {
+        ISR_SERVO_LOGERROR("Bad motion file header");
+
+        return false;
+      }
+
+      this->stream  = &stream;
+      numChannels   = header[4];
+      numFrames     = header[8] | (header[9] << 8) | ( (uint32_t) header[10] << 16) | ( (uint32_t) header[11] << 24);
+
+      memset(pulseWidth, 0, sizeof(pulseWidth));
+
+      front         = 0;
+      pos           = 0;
+      len[0]        = 0;
+      len[1]        = 0;
+      endOfFile     = false;
+      framesPlayed  = 0;
+      skippedFrames = 0;
+      publishErrors = 0;
+      dirtyMask     = 0;
+
+      refill(0);
+      refillBack();
+
+      startFrame    = controller.getFrameCount();
+      playing       = true;
+
+      ISR_SERVO_LOGDEBUG3("Motion channels =", numChannels, ", frames =", numFrames);
+
+      return true;
+    }
+
+    // Call from loop() as often as possible, at least once per frame
+    // Decodes the frames due since the last call, publishes the last one to the controller, then refills the buffers
+    // returns false when playback is over
+    bool update()
+    {
+      uint32_t  dueFrames;
+      uint32_t  decodedFrames = 0;
+
+      if (!playing)
+        return false;
+
+      dueFrames = controller.getFrameCount() - startFrame;
+
+      // If loop() was late, decode all missed frames to keep the deltas right, but only the last one is sent
+      while ( (framesPlayed < dueFrames) && (framesPlayed < numFrames) )
+      {
+        // Catching up may consume both buffers : the refill can't wait for the frame to be sent then
+        if ( (buffered() < ISR_SERVO_MOTION_MAX_FRAME_SIZE) && (len[front ^ 1] == 0) )
+          refillBack();
+
+        if (!decodeFrame(dirtyMask))
+        {
+          ISR_SERVO_LOGERROR("Truncated motion file");
+
+          framesPlayed = numFrames;
+          break;
+        }
+
+        framesPlayed++;
+        decodedFrames++;
+      }
+
+      if (decodedFrames > 1)
+        skippedFrames += decodedFrames - 1;
+
+      // Channels not sent yet, in this frame or a failed previous one
+      if (dirtyMask)
+        publish();
+
+      // Usually, file I/O only after the frame is sent
+      if (len[front ^ 1] == 0)
+        refillBack();
+
+      if (framesPlayed >= numFrames)
+        playing = false;
+
+      return playing;
+    }
+
+    void stop()
+    {
+      playing = false;
+    }
+
+    bool isPlaying()
+    {
+      return playing;
+    }
+
+    // returns the number of file frames played
+    uint32_t getFramesPlayed()
+    {
+      return framesPlayed;
+    }
+
+    // returns the number of frames decoded but not sent, because update() was called too late
+    uint32_t getSkippedFrames()
+    {
+      return skippedFrames;
+    }
+
+    // returns the number of frames the controller refused, e.g. because a servo is disabled
+    // Their channels are sent again with the next frame
+    uint32_t getPublishErrors()
+    {
+      return publishErrors;
+    }
+
+  private:
+
+    // fill buffer from the stream
+    void refill(const uint8_t& index)
+    {
+      len[index] = stream->readBytes((char*) buffer[index], ISR_SERVO_MOTION_CHUNK_SIZE);
+
+      if (len[index] < ISR_SERVO_MOTION_CHUNK_SIZE)
+        endOfFile = true;
+    }
+
+    // fill the buffer following the one being decoded
+    void refillBack()
+    {
+      if (!endOfFile)
+        refill(front ^ 1);
+    }
+
+    // returns the number of bytes available in both buffers
+    uint16_t buffered()
+    {
+      return (len[front] - pos) + len[front ^ 1];
+    }
+
+    // returns false when no more byte
+    bool nextByte(uint8_t& value)
+    {
+      if (pos >= len[front])
+      {
+        // Front buffer consumed, switch to the back one. The consumed one is refilled by update()
+        len[front]  = 0;
+        front      ^= 1;
+        pos         = 0;
+
+        if (len[front] == 0)
+          return false;
+      }
+
+      value = buffer[front][pos++];
+
+      return true;
+    }
+
+    bool decodeFrame(uint16_t& changedMask)
+    {
+      uint8_t   lo, hi;
+      uint16_t  mask;
+
+      if ( !nextByte(lo) || !nextByte(hi) )
+        return false;
+
+      mask = lo | (hi << 8);
+
+      for (uint8_t channel = 0; channel < numChannels; channel++)
+      {
+        if ( !(mask & (1 << channel)) )
+          continue;
+
+        if (!nextByte(lo))
+          return false;
+
+        if ( (int8_t) lo == ISR_SERVO_MOTION_ABSOLUTE )
+        {
+          if ( !nextByte(lo) || !nextByte(hi) )
+            return false;
+
+          pulseWidth[channel] = lo | (hi << 8);
+        }
+        else
+        {
+          pulseWidth[channel] += (int8_t) lo;
+        }
+
+        changedMask |= (1 << channel);
+      }
+
+      return true;
+    }
+
+    // send the changed channels to the controller, applied together at its next frame start
+    // dirtyMask is only cleared when the controller accepts them
+    void publish()
+    {
+      ESP8266_ISR_Servo_Group group;
+      uint16_t                slotWidth[16];
+      uint16_t                values[16];
+      uint8_t                 numValues = 0;
+      uint8_t                 slot;
+
+      for (uint8_t channel = 0; channel < numChannels; channel++)
+      {
+        if ( (dirtyMask & (1 << channel)) && (pulseWidth[channel] != 0) )
+        {
+          slot = servoIndex[channel] & ISR_SERVO_SLOT_MASK;
+          slotWidth[slot] = pulseWidth[channel];
+          group.add(servoIndex[channel]);
+        }
+      }
+
+      // Group values are in ascending slot order
+      for (slot = 0; slot < 16; slot++)
+      {
+        if (group.getMask() & (1 << slot))
+          values[numValues++] = slotWidth[slot];
+      }
+
+      if ( numValues && !controller.setPulseWidths(group, values) )
+      {
+        ISR_SERVO_LOGERROR1("Motion frame refused, channels =", dirtyMask);
+
+        publishErrors++;
+
+        return;
+      }
+
+      dirtyMask = 0;
+    }
+
+    ESP8266_ISR_Servo&  controller;
+    const int8_t*       servoIndex;
+    uint8_t             numServos;
+
+    Stream*             stream;
+    bool                playing;
+    bool                endOfFile;
+
+    uint8_t             numChannels;
+    uint32_t            numFrames;
+    uint32_t            startFrame;
+    uint32_t            framesPlayed;
+    uint32_t            skippedFrames;
+    uint32_t            publishErrors;
+
+    // pulse width of each channel, and channels changed since last sent to the controller
+    uint16_t            pulseWidth[16];
+    uint16_t            dirtyMask;
+
+    uint8_t             buffer[2][ISR_SERVO_MOTION_CHUNK_SIZE];
+    uint16_t            len[2];
+    uint16_t            pos;
+    uint8_t             front;
+};
+
+#endif    // ESP8266_ISR_SERVO_MOTION_H
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+#
+# Write the CSV motion played by test_motion : smooth, step, late start and random channels,
+# so that the motion file has both relative and absolute changes, and frames with no change.
+#
+# Usage: motion_csv.py motion.csv
+
+import math
+import random
+import sys
+
+NUM_FRAMES = 1200
+
+
+def main():
+    random.seed(1)
+    noisy = 1500
+
+    with open(sys.argv[1], "w") as csv_file:
+        csv_file.write("# smooth, steps, late start, random\n")
+
+        for frame in range(NUM_FRAMES):
+            smooth = int(1500 + 600 * math.sin(2 * math.pi * frame / 150))
+            step = 900 if (frame // 100) % 2 else 2100
+            late = "" if frame < 40 else str(1000 + (frame % 200) * 3)
+
+            if random.random() < 0.1:
+                noisy = random.randint(700, 2300)
+            elif random.random() < 0.5:
+                noisy = min(2300, max(700, noisy + random.randint(-127, 127)))
+
+            # Hold some frames entirely
+            if 500 <= frame < 520:
+                csv_file.write(",,,\n")
+            else:
+                csv_file.write("%d,%d,%s,%d\n" % (smooth, step, late, noisy))
+
+
+if __name__ == "__main__":
+    main()
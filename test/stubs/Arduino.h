@@ -0,0 +1,218 @@
+// Minimal Arduino core for the host tests : simulated pins, cycle counter and interrupts, no hardware
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+#define IRAM_ATTR
+#define PROGMEM
+
+#define HIGH      1
+#define LOW       0
+#define OUTPUT    1
+
+#define F_CPU     80000000L
+
+#define D1        5
+#define D2        4
+#define D3        0
+#define D4        2
+#define D5        14
+#define D6        12
+#define D7        13
+#define D8        15
+
+#define ARDUINO_BOARD   "host"
+
+typedef bool boolean;
+
+// Defined by test_harness.h
+extern int      pinLevel[32];
+extern uint32_t simCycles;
+
+// GPIO output set (GPOS) / clear (GPOC) registers: writing 1 to a bit sets / clears that pin in pinLevel
+struct GpioMaskRegister
+{
+  uint8_t level;
+
+  GpioMaskRegister& operator=(const uint32_t& mask)
+  {
+    for (uint8_t pin = 0; pin < 16; pin++)
+    {
+      if (mask & (1 << pin))
+        pinLevel[pin] = level;
+    }
+
+    return *this;
+  }
+};
+
+// GPIO16 output register, bit 0 is the pin level
+struct Gpio16Register
+{
+  Gpio16Register& operator=(const uint32_t& value)
+  {
+    pinLevel[16] = value & 1;
+
+    return *this;
+  }
+};
+
+extern GpioMaskRegister GPOS, GPOC;
+extern Gpio16Register   GP16O;
+
+inline void pinMode(uint8_t, uint8_t) {}
+
+inline void digitalWrite(uint8_t pin, uint8_t level)
+{
+  pinLevel[pin] = level;
+}
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// run() is only called from the test thread, so there is nothing to block
+inline void noInterrupts() {}
+inline void interrupts() {}
+
+enum TIM_DIV_ENUM
+{
+  TIM_DIV1    = 0,
+  TIM_DIV16   = 1,
+  TIM_DIV256  = 3
+};
+
+#define TIM_EDGE    0
+#define TIM_LEVEL   1
+#define TIM_SINGLE  0
+#define TIM_LOOP    1
+
+inline void timer1_attachInterrupt(void (*)()) {}
+inline void timer1_write(uint32_t) {}
+inline void timer1_enable(int, int, int) {}
+inline void timer1_disable() {}
+
+inline unsigned long micros()
+{
+  return simCycles / 80;
+}
+
+inline void delay(unsigned long) {}
+
+#define F(x)      x
+
+class Print
+{
+  public:
+
+    virtual ~Print() {}
+
+    virtual size_t write(const char* str) = 0;
+
+    size_t print(const char* str)
+    {
+      return write(str);
+    }
+
+    size_t print(char c)
+    {
+      char str[2] = { c, 0 };
+
+      return write(str);
+    }
+
+    size_t print(double value, int digits = 2)
+    {
+      char str[32];
+
+      snprintf(str, sizeof(str), "%.*f", digits, value);
+
+      return write(str);
+    }
+
+    size_t print(long value)
+    {
+      char str[24];
+
+      snprintf(str, sizeof(str), "%ld", value);
+
+      return write(str);
+    }
+
+    size_t print(unsigned long value)
+    {
+      char str[24];
+
+      snprintf(str, sizeof(str), "%lu", value);
+
+      return write(str);
+    }
+
+    size_t print(int value)           { return print( (long) value); }
+    size_t print(unsigned int value)  { return print( (unsigned long) value); }
+    size_t print(uint8_t value)       { return print( (unsigned long) value); }
+    size_t print(uint16_t value)      { return print( (unsigned long) value); }
+
+    template<class T> size_t println(T value)
+    {
+      return print(value) + write("\n");
+    }
+
+    size_t println()
+    {
+      return write("\n");
+    }
+};
+
+// Collects the output in a string
+class StringPrint : public Print
+{
+  public:
+
+    size_t write(const char* str)
+    {
+      text += str;
+
+      return strlen(str);
+    }
+
+    std::string text;
+};
+
+class Stream
+{
+  public:
+
+    virtual ~Stream() {}
+
+    virtual size_t readBytes(char* buffer, size_t length) = 0;
+};
+
+class EspClass
+{
+  public:
+
+    uint32_t getCycleCount()
+    {
+      return simCycles;
+    }
+
+    uint32_t getCpuFreqMHz()
+    {
+      return F_CPU / 1000000L;
+    }
+};
+
+extern EspClass ESP;
+
+extern StringPrint Serial;
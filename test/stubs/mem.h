@@ -0,0 +1 @@
+// Empty on the host, see Arduino.h
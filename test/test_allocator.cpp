@@ -0,0 +1,86 @@
+// Slot allocator and generation-tagged servoIndex : allocate / delete / reuse churn
+
+#include "ESP8266_ISR_Servo.h"
+#include "test_harness.h"
+
+int main()
+{
+  int8_t  servoIndex[ESP8266_ISR_Servo::MAX_SERVOS];
+  uint8_t slot;
+
+  // Allocate all slots, in order, with generation 0
+  for (slot = 0; slot < ESP8266_ISR_Servo::MAX_SERVOS; slot++)
+  {
+    servoIndex[slot] = ISR_Servo.setupServo(slot);
+    CHECK(servoIndex[slot] == slot);
+  }
+
+  CHECK(ISR_Servo.getNumServos() == ESP8266_ISR_Servo::MAX_SERVOS);
+  CHECK(ISR_Servo.getNumAvailableServos() == 0);
+  CHECK(ISR_Servo.setupServo(1) == -1);
+
+  // Delete and reallocate : same slot, next generation
+  ISR_Servo.deleteServo(servoIndex[5]);
+  CHECK(ISR_Servo.getNumServos() == ESP8266_ISR_Servo::MAX_SERVOS - 1);
+
+  int8_t newIndex = ISR_Servo.setupServo(5);
+  CHECK( (newIndex & ISR_SERVO_SLOT_MASK) == 5);
+  CHECK( (newIndex >> 4) == 1);
+
+  // Stale handle rejected, the new one accepted
+  CHECK(!ISR_Servo.setPosition(servoIndex[5], 90));
+  CHECK(ISR_Servo.getPosition(servoIndex[5]) == -1);
+  CHECK(ISR_Servo.getPulseWidth(servoIndex[5]) == 0);
+  CHECK(!ISR_Servo.enable(servoIndex[5]));
+  CHECK(ISR_Servo.setPosition(newIndex, 90));
+  CHECK(ISR_Servo.getPosition(newIndex) == 90);
+
+  // Deleting through a stale handle leaves the new servo alone
+  ISR_Servo.deleteServo(servoIndex[5]);
+  CHECK(ISR_Servo.getNumServos() == ESP8266_ISR_Servo::MAX_SERVOS);
+  CHECK(ISR_Servo.getPosition(newIndex) == 90);
+
+  // Stale group member rejected, the new servo not moved
+  ESP8266_ISR_Servo_Group group;
+  uint16_t                positions[1] = { 180 };
+
+  group.add(newIndex);
+  ISR_Servo.deleteServo(newIndex);
+  newIndex = ISR_Servo.setupServo(5);
+  CHECK(!group.contains(newIndex));
+  CHECK(!ISR_Servo.setPositions(group, positions));
+  CHECK(!ISR_Servo.enable(group));
+  CHECK(!ISR_Servo.disable(group));
+  runFrames(ISR_Servo, 2);
+  CHECK(ISR_Servo.getPulseWidth(newIndex) == MIN_PULSE_WIDTH / TIMER_INTERVAL_MICRO * TIMER_INTERVAL_MICRO);
+
+  group.clear();
+  group.add(newIndex);
+  CHECK(ISR_Servo.setPositions(group, positions));
+
+  // A disabled slot is still allocated, and not reused
+  ISR_Servo.disable(servoIndex[3]);
+  ISR_Servo.deleteServo(servoIndex[7]);
+  CHECK(ISR_Servo.setupServo(7) == (servoIndex[7] | (1 << 4)));
+  CHECK(ISR_Servo.setupServo(3) == -1);
+  CHECK(!ISR_Servo.isEnabled(servoIndex[3]));
+  CHECK(ISR_Servo.enable(servoIndex[3]));
+
+  // Churn one slot : the generation wraps after 8 deletes, giving back the first handle of the slot
+  ISR_Servo.deleteServo(servoIndex[0]);
+
+  for (uint8_t round = 1; round <= 8; round++)
+  {
+    newIndex = ISR_Servo.setupServo(0);
+    CHECK(newIndex == ( (round & ISR_SERVO_GENERATION_MASK) << 4) );
+
+    if (round < 8)
+      ISR_Servo.deleteServo(newIndex);
+  }
+
+  CHECK(newIndex == servoIndex[0]);
+  CHECK(ISR_Servo.setPosition(servoIndex[0], 45));
+  CHECK(ISR_Servo.getNumServos() == ESP8266_ISR_Servo::MAX_SERVOS);
+
+  return testResult("test_allocator");
+}
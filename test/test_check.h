@@ -0,0 +1,24 @@
+// CHECK() and test result, shared by all host tests
+
+#pragma once
+
+#include <stdio.h>
+
+static int testFailures = 0;
+
+#define CHECK(cond)                                                               \
+  do                                                                              \
+  {                                                                               \
+    if (!(cond))                                                                  \
+    {                                                                             \
+      printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond);            \
+      testFailures++;                                                             \
+    }                                                                             \
+  } while (0)
+
+inline int testResult(const char* name)
+{
+  printf("%s: %s\n", name, testFailures ? "FAILED" : "passed");
+
+  return testFailures ? 1 : 0;
+}
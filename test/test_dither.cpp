@@ -0,0 +1,120 @@
+// Dithering : the pulse width output over many frames averages the commanded one to the microsec,
+// for single updates, slew-limited moves and group updates
+
+#include "ESP8266_ISR_Servo.h"
+#include "test_harness.h"
+
+#include <math.h>
+
+#define AVERAGE_FRAMES    100
+
+// Average pulse width of the servo in slot over the next frames, in microsecs, as output by run()
+static double averageWidth(const uint8_t& slot)
+{
+  ServoSnapshot snap;
+  uint32_t      sum = 0;
+
+  for (uint16_t frame = 0; frame < AVERAGE_FRAMES; frame++)
+  {
+    runFrames(ISR_Servo, 1);
+    ISR_Servo.snapshot(snap);
+    sum += snap.pulseWidth[slot];
+  }
+
+  return (double) sum / AVERAGE_FRAMES;
+}
+
+// Run until the servo has reached target, returning false if it takes more than maxFrames
+// The output must change by at most maxStep microsecs per frame
+static bool slewTo(const int8_t& servoIndex, const uint16_t& target, const uint16_t& maxStep, const uint16_t& maxFrames)
+{
+  ServoSnapshot snap;
+  uint8_t       slot = servoIndex & ISR_SERVO_SLOT_MASK;
+  uint16_t      last;
+
+  ISR_Servo.snapshot(snap);
+  last = snap.pulseWidth[slot];
+
+  for (uint16_t frame = 0; frame < maxFrames; frame++)
+  {
+    runFrames(ISR_Servo, 1);
+    ISR_Servo.snapshot(snap);
+
+    if (abs(snap.pulseWidth[slot] - last) > maxStep)
+      return false;
+
+    last = snap.pulseWidth[slot];
+
+    // Once there, within the 2 timer counts around target
+    if (!ISR_Servo.isMoving(servoIndex))
+      return (abs(last - target) < TIMER_INTERVAL_MICRO);
+  }
+
+  return false;
+}
+
+int main()
+{
+  int8_t    servo0 = ISR_Servo.setupServo(D1);
+  int8_t    servo1 = ISR_Servo.setupServo(D2);
+  uint8_t   slot0  = servo0 & ISR_SERVO_SLOT_MASK;
+  uint8_t   slot1  = servo1 & ISR_SERVO_SLOT_MASK;
+  uint16_t  pulseWidth;
+  bool      sweepOK = true;
+
+  CHECK(ISR_Servo.setDithering(servo0, true));
+  CHECK(ISR_Servo.isDithering(servo0));
+  CHECK(!ISR_Servo.isDithering(servo1));
+
+  // Every microsec of a sweep across 2 timer counts
+  for (uint16_t width = 1000; width <= 1020; width++)
+  {
+    pulseWidth = width;
+    CHECK(ISR_Servo.setPulseWidth(servo0, pulseWidth));
+    CHECK(ISR_Servo.getPulseWidth(servo0) == width);
+
+    if (fabs(averageWidth(slot0) - width) >= 1.0)
+    {
+      printf("Sweep average off at %u us\n", width);
+      sweepOK = false;
+    }
+  }
+
+  CHECK(sweepOK);
+
+  // Without dithering, truncated to the timer count
+  pulseWidth = 1017;
+  CHECK(ISR_Servo.setPulseWidth(servo1, pulseWidth));
+  CHECK(fabs(averageWidth(slot1) - 1010) < 1.0);
+
+  // Slew-limited move : dithered once at the target
+  CHECK(ISR_Servo.setSlewRate(servo0, 20));
+  pulseWidth = 1503;
+  CHECK(ISR_Servo.setPulseWidth(servo0, pulseWidth));
+  CHECK(ISR_Servo.isMoving(servo0));
+  CHECK(slewTo(servo0, 1503, 20, 30));
+  CHECK(fabs(averageWidth(slot0) - 1503) < 1.0);
+
+  // Group update, slew-limited and dithered member with a plain one, applied together at the next frame
+  ESP8266_ISR_Servo_Group group;
+  uint16_t                pulseWidths[2] = { 1207, 1994 };
+
+  group.add(servo0);
+  group.add(servo1);
+
+  CHECK(ISR_Servo.setPulseWidths(group, pulseWidths));
+  CHECK(ISR_Servo.isMoving(servo0));
+  CHECK(slewTo(servo0, 1207, 20, 20));
+  CHECK(ISR_Servo.getPulseWidth(servo1) == 1990);
+  CHECK(fabs(averageWidth(slot0) - 1207) < 1.0);
+  CHECK(fabs(averageWidth(slot1) - 1990) < 1.0);
+
+  // Back to truncation when turned off
+  CHECK(ISR_Servo.setDithering(servo0, false));
+  pulseWidth = 1305;
+  CHECK(ISR_Servo.setPulseWidth(servo0, pulseWidth));
+  CHECK(slewTo(servo0, 1300, 20, 10));
+  CHECK(fabs(averageWidth(slot0) - 1300) < 1.0);
+
+  return testResult("test_dither");
+}
@@ -0,0 +1,69 @@
+// Change detection and dead-band : suppressed updates and their counters, on single and group updates
+
+#include "ESP8266_ISR_Servo.h"
+#include "test_harness.h"
+
+int main()
+{
+  int8_t        servo0 = ISR_Servo.setupServo(D1);
+  int8_t        servo1 = ISR_Servo.setupServo(D2);
+  uint16_t      pulseWidth;
+  unsigned long applied, suppressed;
+
+  // Same position twice : the second one is suppressed
+  CHECK(ISR_Servo.setPosition(servo0, 90));
+  CHECK(ISR_Servo.setPosition(servo0, 90));
+  CHECK(ISR_Servo.getUpdateStats(servo0, applied, suppressed));
+  CHECK( (applied == 1) && (suppressed == 1) );
+
+  // Same timer count : suppressed, the position is kept
+  pulseWidth = ISR_Servo.getPulseWidth(servo0) + 1;
+  CHECK(ISR_Servo.setPulseWidth(servo0, pulseWidth));
+  CHECK(ISR_Servo.getUpdateStats(servo0, applied, suppressed));
+  CHECK( (applied == 1) && (suppressed == 2) );
+  CHECK(ISR_Servo.getPosition(servo0) == 90);
+
+  // The position mapped back from a pulse width is truncated : the same position in degrees still moves the servo
+  ISR_Servo.resetUpdateStats(servo0);
+  pulseWidth = 1000;
+  CHECK(ISR_Servo.setPulseWidth(servo0, pulseWidth));
+  CHECK(ISR_Servo.getPosition(servo0) == 44);
+  CHECK(ISR_Servo.setPosition(servo0, 44));
+  CHECK(ISR_Servo.getPulseWidth(servo0) == 990);
+  CHECK(ISR_Servo.getUpdateStats(servo0, applied, suppressed));
+  CHECK( (applied == 2) && (suppressed == 0) );
+
+  // Group updates : unchanged members are counted as suppressed, the others as applied
+  ESP8266_ISR_Servo_Group group;
+  uint16_t                positions[2] = { 30, 150 };
+
+  group.add(servo0);
+  group.add(servo1);
+  ISR_Servo.resetUpdateStats(servo0);
+  ISR_Servo.resetUpdateStats(servo1);
+
+  CHECK(ISR_Servo.setPositions(group, positions));
+  CHECK(ISR_Servo.setPositions(group, positions));
+  positions[1] = 160;
+  CHECK(ISR_Servo.setPositions(group, positions));
+
+  CHECK(ISR_Servo.getUpdateStats(servo0, applied, suppressed));
+  CHECK( (applied == 1) && (suppressed == 2) );
+  CHECK(ISR_Servo.getUpdateStats(servo1, applied, suppressed));
+  CHECK( (applied == 2) && (suppressed == 1) );
+
+  runFrames(ISR_Servo, 1);
+  CHECK(ISR_Servo.getPosition(servo1) == 160);
+
+  // Dead-band : small moves suppressed, larger ones applied
+  CHECK(ISR_Servo.setDeadband(servo1, 50));
+  ISR_Servo.resetUpdateStats(servo1);
+  pulseWidth = ISR_Servo.getPulseWidth(servo1) - 40;
+  CHECK(ISR_Servo.setPulseWidth(servo1, pulseWidth));
+  pulseWidth -= 20;
+  CHECK(ISR_Servo.setPulseWidth(servo1, pulseWidth));
+  CHECK(ISR_Servo.getUpdateStats(servo1, applied, suppressed));
+  CHECK( (applied == 1) && (suppressed == 1) );
+
+  return testResult("test_filter");
+}
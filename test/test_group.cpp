@@ -0,0 +1,56 @@
+// Group operations : enable / disable of all members together, on simulated pins, and order of the group values
+
+#include "ESP8266_ISR_Servo.h"
+#include "test_harness.h"
+
+int main()
+{
+  int8_t  servo0 = ISR_Servo.setupServo(D1);
+  int8_t  servo1 = ISR_Servo.setupServo(D2);
+
+  ESP8266_ISR_Servo_Group group;
+
+  group.add(servo0);
+  group.add(servo1);
+
+  CHECK(ISR_Servo.setPosition(servo0, 90));
+  CHECK(ISR_Servo.setPosition(servo1, 180));
+  runFrames(ISR_Servo, 1);
+
+  // Disabled during the pulses : both pins go LOW at once, and stay LOW
+  runTicks(ISR_Servo, 50);
+  CHECK( (pinLevel[D1] == HIGH) && (pinLevel[D2] == HIGH) );
+  CHECK(ISR_Servo.disable(group));
+  CHECK( (pinLevel[D1] == LOW) && (pinLevel[D2] == LOW) );
+  CHECK(!ISR_Servo.isEnabled(servo0) && !ISR_Servo.isEnabled(servo1));
+
+  // Back to the frame start
+  runTicks(ISR_Servo, REFRESH_INTERVAL / TIMER_INTERVAL_MICRO - 50);
+  runFrames(ISR_Servo, 2);
+  CHECK( (pinLevel[D1] == LOW) && (pinLevel[D2] == LOW) );
+
+  // Enabled again : pulses from the next frame start
+  CHECK(ISR_Servo.enable(group));
+  runFrames(ISR_Servo, 1);
+  runTicks(ISR_Servo, 50);
+  CHECK( (pinLevel[D1] == HIGH) && (pinLevel[D2] == HIGH) );
+  runTicks(ISR_Servo, 150);
+  CHECK( (pinLevel[D1] == LOW) && (pinLevel[D2] == HIGH) );
+
+  // Values in slot order : slot 0 set up again has servoIndex 16, above servo1 in slot 1
+  uint16_t pulseWidths[2] = { 1000, 2000 };
+
+  ISR_Servo.deleteServo(servo0);
+  servo0 = ISR_Servo.setupServo(D1);
+  CHECK(servo0 == 16);
+
+  group.clear();
+  group.add(servo1);
+  group.add(servo0);
+  CHECK(ISR_Servo.setPulseWidths(group, pulseWidths));
+  runFrames(ISR_Servo, 1);
+  CHECK(ISR_Servo.getPulseWidth(servo0) == 1000);
+  CHECK(ISR_Servo.getPulseWidth(servo1) == 2000);
+
+  return testResult("test_group");
+}
@@ -0,0 +1,35 @@
+// Shared helpers of the host tests. Include once per test program, after ESP8266_ISR_Servo.h
+
+#pragma once
+
+#include "test_check.h"
+
+// Directory of the files read and written by the tests, set by the Makefile from BUILD
+#ifndef TEST_BUILD_DIR
+  #define TEST_BUILD_DIR  "build"
+#endif
+
+int       pinLevel[32];
+uint32_t  simCycles;
+
+GpioMaskRegister  GPOS = { HIGH };
+GpioMaskRegister  GPOC = { LOW };
+Gpio16Register    GP16O;
+
+EspClass    ESP;
+StringPrint Serial;
+
+// Call run() as the timer1 interrupt would, every TIMER_INTERVAL_MICRO
+inline void runTicks(ESP8266_ISR_Servo& controller, const uint32_t& ticks)
+{
+  for (uint32_t tick = 0; tick < ticks; tick++)
+  {
+    controller.run();
+    simCycles += (F_CPU / 1000000L) * TIMER_INTERVAL_MICRO;
+  }
+}
+
+inline void runFrames(ESP8266_ISR_Servo& controller, const uint32_t& frames)
+{
+  runTicks(controller, frames * (REFRESH_INTERVAL / TIMER_INTERVAL_MICRO));
+}
@@ -0,0 +1,84 @@
+// ISR_SERVO_MINIMAL_FOOTPRINT : the frame start features are compiled out, the pins are driven by direct GPIO writes
+
+#include "ESP8266_ISR_Servo.h"
+#include "test_harness.h"
+
+#if (ISR_SERVO_USE_GROUPS || ISR_SERVO_USE_SLEW || ISR_SERVO_USE_SYNC || ISR_SERVO_USE_DITHER || ISR_SERVO_USE_OSCILLATOR)
+  #error ISR_SERVO_MINIMAL_FOOTPRINT must turn all frame start features off
+#endif
+
+#define FRAME_TICKS     (REFRESH_INTERVAL / TIMER_INTERVAL_MICRO)
+
+// Run one frame, returning the HIGH time of pin in microsecs, or 0 if not exactly one pulse
+static uint16_t measureFrame(const uint8_t& pin)
+{
+  uint16_t  highTicks = 0;
+  uint8_t   rises = 0;
+  int       level = pinLevel[pin];
+
+  for (uint16_t tick = 0; tick < FRAME_TICKS; tick++)
+  {
+    runTicks(ISR_Servo, 1);
+
+    if (pinLevel[pin] && !level)
+      rises++;
+
+    if (pinLevel[pin])
+      highTicks++;
+
+    level = pinLevel[pin];
+  }
+
+  return (rises == 1) ? highTicks * TIMER_INTERVAL_MICRO : 0;
+}
+
+int main()
+{
+  int8_t    servo0 = ISR_Servo.setupServo(D1);
+  int8_t    servo1 = ISR_Servo.setupServo(16);
+  uint16_t  pulseWidth;
+
+  CHECK(ESP8266_ISR_Servo::MAX_SERVOS == 4);
+  CHECK( (servo0 >= 0) && (servo1 >= 0) );
+
+  // Both the GPOS / GPOC pins and GPIO16 follow the pulse widths, applied at once
+  pulseWidth = 1000;
+  CHECK(ISR_Servo.setPulseWidth(servo0, pulseWidth));
+  pulseWidth = 2000;
+  CHECK(ISR_Servo.setPulseWidth(servo1, pulseWidth));
+  CHECK(!ISR_Servo.isMoving(servo0));
+
+  runFrames(ISR_Servo, 1);
+  CHECK(measureFrame(D1) == 990);
+
+  runFrames(ISR_Servo, 1);
+  CHECK(measureFrame(16) == 1990);
+
+  // Without dithering, the pulse width is truncated to TIMER_INTERVAL_MICRO
+  pulseWidth = 1507;
+  CHECK(ISR_Servo.setPulseWidth(servo0, pulseWidth));
+  CHECK(ISR_Servo.getPulseWidth(servo0) == 1500);
+
+  runFrames(ISR_Servo, 1);
+  CHECK(measureFrame(D1) == 1490);
+
+  // Frames keep their nominal length
+  uint32_t frame = ISR_Servo.getFrameCount();
+
+  runFrames(ISR_Servo, 10);
+  CHECK(ISR_Servo.getFrameCount() == frame + 10);
+
+  // Disabled servo stays LOW
+  CHECK(ISR_Servo.disable(servo1));
+  runFrames(ISR_Servo, 1);
+  CHECK(measureFrame(16) == 0);
+  CHECK(pinLevel[16] == LOW);
+
+  ServoSnapshot snap;
+
+  ISR_Servo.snapshot(snap);
+  CHECK(snap.pulseWidth[servo0 & ISR_SERVO_SLOT_MASK] == 1500);
+  CHECK(snap.enabledMask == (1 << (servo0 & ISR_SERVO_SLOT_MASK)));
+
+  return testResult("test_minimal");
+}
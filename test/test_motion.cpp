@@ -0,0 +1,185 @@
+// Motion file playback : a CSV encoded by utils/motion_encoder.py is played against the controller,
+// and the pulse width of every servo is checked at every frame
+
+#include "ESP8266_ISR_Servo.h"
+#include "ESP8266_ISR_Servo_Motion.h"
+#include "test_harness.h"
+
+#include <vector>
+
+#define NUM_CHANNELS    4
+
+class FileStream : public Stream
+{
+  public:
+
+    explicit FileStream(const char* path)
+    {
+      file = fopen(path, "rb");
+    }
+
+    ~FileStream()
+    {
+      if (file)
+        fclose(file);
+    }
+
+    size_t readBytes(char* buffer, size_t length)
+    {
+      return file ? fread(buffer, 1, length, file) : 0;
+    }
+
+    FILE* file;
+};
+
+typedef std::vector<std::vector<uint16_t> > Motion;
+
+// Expected pulse widths of each frame, 0 while a channel is not driven yet
+static Motion readCSV(const char* path)
+{
+  Motion    motion;
+  FILE*     file = fopen(path, "r");
+  char      line[128];
+  uint16_t  current[NUM_CHANNELS] = { 0 };
+
+  while (file && fgets(line, sizeof(line), file))
+  {
+    if (line[0] == '#')
+      continue;
+
+    char* cell = line;
+
+    for (uint8_t channel = 0; channel < NUM_CHANNELS; channel++)
+    {
+      if ( (*cell != ',') && (*cell != '\n') )
+        current[channel] = strtoul(cell, &cell, 10);
+
+      if (*cell == ',')
+        cell++;
+    }
+
+    motion.push_back(std::vector<uint16_t>(current, current + NUM_CHANNELS));
+  }
+
+  if (file)
+    fclose(file);
+
+  return motion;
+}
+
+static int8_t servoIndex[NUM_CHANNELS];
+
+static bool matches(const std::vector<uint16_t>& expected)
+{
+  for (uint8_t channel = 0; channel < NUM_CHANNELS; channel++)
+  {
+    if ( (expected[channel] != 0) && (ISR_Servo.getPulseWidth(servoIndex[channel]) != expected[channel]) )
+      return false;
+  }
+
+  return true;
+}
+
+int main()
+{
+  Motion  motion = readCSV(TEST_BUILD_DIR "/motion.csv");
+  size_t  frame;
+
+  CHECK(motion.size() == 1200);
+
+  // With dithering, getPulseWidth() returns the exact microsecs
+  for (uint8_t channel = 0; channel < NUM_CHANNELS; channel++)
+  {
+    servoIndex[channel] = ISR_Servo.setupServo(D1 + channel, 500, 2500);
+    ISR_Servo.setDithering(servoIndex[channel], true);
+  }
+
+  // update() every frame : each file frame is applied at the start of the next servo frame
+  {
+    ESP8266_ISR_Servo_Motion  player(ISR_Servo, servoIndex, NUM_CHANNELS);
+    FileStream                stream(TEST_BUILD_DIR "/motion.ism");
+    uint32_t                  mismatches = 0;
+
+    CHECK(player.begin(stream));
+
+    for (frame = 0; player.isPlaying(); frame++)
+    {
+      runFrames(ISR_Servo, 1);
+
+      if ( (frame > 0) && !matches(motion[frame - 1]) )
+        mismatches++;
+
+      player.update();
+    }
+
+    runFrames(ISR_Servo, 1);
+
+    CHECK(mismatches == 0);
+    CHECK(matches(motion.back()));
+    CHECK(frame == motion.size());
+    CHECK(player.getFramesPlayed() == motion.size());
+    CHECK(player.getSkippedFrames() == 0);
+    CHECK(player.getPublishErrors() == 0);
+  }
+
+  // update() every 3 frames : the frames in between are decoded but not sent
+  {
+    ESP8266_ISR_Servo_Motion  player(ISR_Servo, servoIndex, NUM_CHANNELS);
+    FileStream                stream(TEST_BUILD_DIR "/motion.ism");
+    uint32_t                  mismatches = 0;
+
+    CHECK(player.begin(stream));
+
+    for (frame = 0; player.isPlaying(); )
+    {
+      runFrames(ISR_Servo, 3);
+      frame += 3;
+
+      // The last frame decoded by the previous update() is applied
+      if ( (frame > 3) && !matches(motion[std::min(frame - 3, motion.size()) - 1]) )
+        mismatches++;
+
+      player.update();
+    }
+
+    runFrames(ISR_Servo, 1);
+    CHECK(matches(motion.back()));
+
+    CHECK(mismatches == 0);
+    CHECK(player.getFramesPlayed() == motion.size());
+    CHECK(player.getSkippedFrames() > 0);
+  }
+
+  // A disabled servo makes the controller refuse the frames. The channels changed meanwhile are sent once enabled again,
+  // including channel 1, changed in frame 100 only
+  {
+    ESP8266_ISR_Servo_Motion  player(ISR_Servo, servoIndex, NUM_CHANNELS);
+    FileStream                stream(TEST_BUILD_DIR "/motion.ism");
+
+    CHECK(player.begin(stream));
+
+    for (frame = 0; frame < 105; frame++)
+    {
+      runFrames(ISR_Servo, 1);
+
+      if (frame == 90)
+        ISR_Servo.disable(servoIndex[3]);
+
+      player.update();
+    }
+
+    CHECK(player.getPublishErrors() > 0);
+
+    // Channel 0 changes at every frame, so it holds a width older than the refused frames
+    CHECK(ISR_Servo.getPulseWidth(servoIndex[0]) != motion[103][0]);
+
+    ISR_Servo.enable(servoIndex[3]);
+    runFrames(ISR_Servo, 1);
+    player.update();
+    runFrames(ISR_Servo, 1);
+
+    CHECK(matches(motion[105]));
+  }
+
+  return testResult("test_motion");
+}
@@ -0,0 +1,165 @@
+// Sine oscillators : integer output against the float sine, and no output step on start, parameter changes and sync
+
+#include "ESP8266_ISR_Servo.h"
+#include "test_harness.h"
+
+#include <math.h>
+
+// Dithered, so that getPulseWidth() returns the oscillator output to the microsec
+static int8_t   servo0, servo1;
+
+// Last output of each servo, and largest change per frame seen by runOscillators()
+static int32_t  lastWidth[2];
+static int32_t  maxChange;
+
+static uint32_t increment(const uint16_t& frequency)
+{
+  return ( ( (uint64_t) frequency << 32) * REFRESH_INTERVAL) / 1000000000ULL;
+}
+
+// Largest change per frame of a steady oscillation, in microsecs
+static int32_t naturalChange(const uint16_t& amplitude, const uint16_t& frequency)
+{
+  return (int32_t) ceil(amplitude * 2 * M_PI * frequency * REFRESH_INTERVAL / 1e9);
+}
+
+static void runOscillators(const uint16_t& frames)
+{
+  maxChange = 0;
+
+  for (uint16_t frame = 0; frame < frames; frame++)
+  {
+    runFrames(ISR_Servo, 1);
+
+    for (uint8_t index = 0; index < 2; index++)
+    {
+      int32_t width = ISR_Servo.getPulseWidth(index ? servo1 : servo0);
+
+      maxChange           = max(maxChange, abs(width - lastWidth[index]));
+      lastWidth[index]    = width;
+    }
+  }
+}
+
+// Run frames, checking the output of servo against center + amplitude * sin(phase), with phase in periods
+// advancing by frequency (milliHz) at each frame from startPhase at the first frame
+static bool matchesSine(const int8_t& servoIndex, const uint16_t& frames, const uint16_t& center, const uint16_t& amplitude,
+                        const uint16_t& frequency, const double& startPhase)
+{
+  bool ok = true;
+
+  for (uint16_t frame = 0; frame < frames; frame++)
+  {
+    runFrames(ISR_Servo, 1);
+
+    double phase    = startPhase + (double) frame * increment(frequency) / 4294967296.0;
+    double expected = center + amplitude * sin(2 * M_PI * phase);
+
+    if (fabs(ISR_Servo.getPulseWidth(servoIndex) - expected) > 1.0)
+    {
+      printf("Frame %u: %u us, expected %.2f us\n", frame, ISR_Servo.getPulseWidth(servoIndex), expected);
+      ok = false;
+    }
+  }
+
+  return ok;
+}
+
+int main()
+{
+  uint16_t  pulseWidth = 1500;
+  uint16_t  limit;
+
+  servo0 = ISR_Servo.setupServo(D1);
+  servo1 = ISR_Servo.setupServo(D2);
+
+  CHECK(ISR_Servo.setDithering(servo0, true));
+  CHECK(ISR_Servo.setDithering(servo1, true));
+  CHECK(ISR_Servo.setPulseWidth(servo0, pulseWidth));
+  CHECK(ISR_Servo.setPulseWidth(servo1, pulseWidth));
+  runOscillators(1);
+
+  // Above half the frame rate
+  CHECK(!ISR_Servo.setOscillator(servo0, 1500, 400, 25001));
+  CHECK(!ISR_Servo.isOscillating(servo0));
+
+  // Start : no step from the held 1500 us, the amplitude ramps up
+  CHECK(ISR_Servo.setOscillator(servo0, 1500, 400, 1000, 90));
+  CHECK(ISR_Servo.isOscillating(servo0));
+  runOscillators(40);
+  CHECK(maxChange <= naturalChange(400, 1000) + ISR_SERVO_OSCILLATOR_RAMP);
+
+  // Then the integer sine follows the float one within 1 us, over more than a period
+  CHECK(matchesSine(servo0, 60, 1500, 400, 1000, 40 * 0.02 + 0.25));
+
+  // Frequency change : continuous phase
+  CHECK(ISR_Servo.setOscillator(servo1, 1500, 400, 1000, 90));
+
+  ESP8266_ISR_Servo_Group group;
+
+  group.add(servo0);
+  group.add(servo1);
+
+  runOscillators(100);
+  CHECK(ISR_Servo.setOscillatorFrequency(group, 2000));
+  runOscillators(100);
+  CHECK(maxChange <= naturalChange(400, 2000));
+
+  // Center, amplitude and phase changes are ramped, the output only moves a little more than the natural motion
+  limit = naturalChange(400, 2000) + ISR_SERVO_OSCILLATOR_RAMP;
+  CHECK(ISR_Servo.setOscillator(servo0, 1800, 400, 2000, 90));
+  runOscillators(100);
+  CHECK(maxChange <= limit);
+
+  CHECK(ISR_Servo.setOscillator(servo0, 1800, 100, 2000, 90));
+  runOscillators(100);
+  CHECK(maxChange <= limit);
+
+  // The phase ramp adds up to ISR_SERVO_OSCILLATOR_PHASE_RAMP degrees per frame to the frequency
+  limit = naturalChange(400, 2000 + ISR_SERVO_OSCILLATOR_PHASE_RAMP * (1000000000UL / REFRESH_INTERVAL) / 360);
+  CHECK(ISR_Servo.setOscillator(servo1, 1500, 400, 2000, 270));
+  runOscillators(100);
+  CHECK(maxChange <= limit);
+
+  // Sync : no step, then both restart together from phase 0, only differing by their phase
+  CHECK(ISR_Servo.setOscillator(servo0, 1500, 400, 2000, 0));
+  CHECK(ISR_Servo.setOscillator(servo1, 1500, 400, 2000, 90));
+  runOscillators(210);
+
+  // Not at a period boundary
+  CHECK(ISR_Servo.syncOscillators(group));
+  runOscillators(100);
+  CHECK(maxChange <= limit);
+
+  // 100 frames of 2 Hz are 4 periods
+  CHECK(matchesSine(servo0, 50, 1500, 400, 2000, 0));
+  CHECK(ISR_Servo.syncOscillators(group));
+  runOscillators(100);
+  CHECK(matchesSine(servo1, 50, 1500, 400, 2000, 0.25));
+
+  // Stop : holds the last output
+  pulseWidth = ISR_Servo.getPulseWidth(servo0);
+  CHECK(ISR_Servo.stopOscillator(servo0));
+  CHECK(!ISR_Servo.isOscillating(servo0));
+  runFrames(ISR_Servo, 10);
+  CHECK(ISR_Servo.getPulseWidth(servo0) == pulseWidth);
+
+  // Disabled servo rejected, as by setPosition()
+  int8_t servo2 = ISR_Servo.setupServo(D3);
+
+  CHECK(ISR_Servo.disable(servo2));
+  CHECK(!ISR_Servo.setOscillator(servo2, 1500, 400, 1000));
+  CHECK(!ISR_Servo.isOscillating(servo2));
+
+  // Group calls leave the members without oscillator alone
+  CHECK(ISR_Servo.enable(servo2));
+  CHECK(ISR_Servo.setPosition(servo2, 90));
+  group.add(servo2);
+  CHECK(ISR_Servo.setOscillatorFrequency(group, 1000));
+  CHECK(ISR_Servo.syncOscillators(group));
+  runFrames(ISR_Servo, 10);
+  CHECK(!ISR_Servo.isOscillating(servo2));
+  CHECK(ISR_Servo.getPulseWidth(servo2) == 1470);
+
+  return testResult("test_oscillator");
+}
@@ -0,0 +1,107 @@
+// I2S frame renderer : the rendered bit-stream is compared against the expected pulse widths
+
+#include "ESP8266_I2S_Servo_Renderer.h"
+#include "test_check.h"
+
+#include <stdlib.h>
+
+#define NUM_SAMPLES     2000
+
+static uint32_t buffer[NUM_SAMPLES];
+
+// Every channel HIGH exactly for its first width[channel] samples, in both halves of every sample
+static bool matches(const ESP8266_I2S_Servo_Renderer& renderer, const uint16_t width[])
+{
+  for (uint16_t sample = 0; sample < NUM_SAMPLES; sample++)
+  {
+    if ( (buffer[sample] >> 16) != (buffer[sample] & 0xFFFF) )
+      return false;
+
+    for (uint8_t channel = 0; channel < ESP8266_I2S_Servo_Renderer::MAX_CHANNELS; channel++)
+    {
+      if (renderer.getLevel(channel, sample) != (sample < width[channel]))
+        return false;
+    }
+  }
+
+  for (uint8_t channel = 0; channel < ESP8266_I2S_Servo_Renderer::MAX_CHANNELS; channel++)
+  {
+    if (renderer.getChannel(channel) != width[channel])
+      return false;
+  }
+
+  return true;
+}
+
+int main()
+{
+  ESP8266_I2S_Servo_Renderer  renderer(buffer, NUM_SAMPLES);
+  uint16_t                    width[ESP8266_I2S_Servo_Renderer::MAX_CHANNELS] = { 0 };
+  static uint32_t             before[NUM_SAMPLES];
+
+  CHECK(renderer.getNumSamples() == NUM_SAMPLES);
+  CHECK(matches(renderer, width));
+
+  // Channels set one by one don't touch the others
+  CHECK(renderer.setChannel(0, 100));
+  width[0] = 100;
+  CHECK(matches(renderer, width));
+
+  CHECK(renderer.setChannel(5, 150));
+  width[5] = 150;
+  CHECK(renderer.setChannel(15, 120));
+  width[15] = 120;
+  CHECK(matches(renderer, width));
+
+  // Grow and shrink
+  CHECK(renderer.setChannel(0, 180));
+  width[0] = 180;
+  CHECK(renderer.setChannel(5, 50));
+  width[5] = 50;
+  CHECK(matches(renderer, width));
+
+  CHECK(renderer.setChannel(5, 50));
+  CHECK(matches(renderer, width));
+
+  CHECK(renderer.setChannel(15, 0));
+  width[15] = 0;
+  CHECK(matches(renderer, width));
+
+  // Clamped to the frame
+  CHECK(renderer.setChannel(3, NUM_SAMPLES + 500));
+  width[3] = NUM_SAMPLES;
+  CHECK(matches(renderer, width));
+
+  CHECK(renderer.setChannel(3, 1));
+  width[3] = 1;
+  CHECK(matches(renderer, width));
+
+  // Wrong channel or sample
+  memcpy(before, buffer, sizeof(buffer));
+  CHECK(!renderer.setChannel(16, 100));
+  CHECK(memcmp(before, buffer, sizeof(buffer)) == 0);
+  CHECK(renderer.getChannel(16) == 0);
+  CHECK(!renderer.getLevel(16, 0));
+  CHECK(!renderer.getLevel(0, NUM_SAMPLES));
+
+  // Random updates against the expected widths
+  srand(1);
+
+  for (uint16_t update = 1; update <= 2000; update++)
+  {
+    uint8_t channel = rand() % ESP8266_I2S_Servo_Renderer::MAX_CHANNELS;
+    uint16_t newWidth = rand() % (NUM_SAMPLES + 100);
+
+    renderer.setChannel(channel, newWidth);
+    width[channel] = (newWidth > NUM_SAMPLES) ? NUM_SAMPLES : newWidth;
+
+    if ( (update % 100) == 0)
+      CHECK(matches(renderer, width));
+  }
+
+  renderer.clear();
+  memset(width, 0, sizeof(width));
+  CHECK(matches(renderer, width));
+
+  return testResult("test_renderer");
+}
@@ -0,0 +1,62 @@
+// Scheduled moves : reported once applied, replaced by immediate updates, and a new reference for change detection
+
+#include "ESP8266_ISR_Servo.h"
+#include "test_harness.h"
+
+int main()
+{
+  int8_t        servo0 = ISR_Servo.setupServo(D1);
+  int8_t        servo1 = ISR_Servo.setupServo(D2);
+  uint8_t       slot0  = servo0 & ISR_SERVO_SLOT_MASK;
+  uint16_t      pulseWidth;
+  ServoSnapshot snap;
+
+  CHECK(ISR_Servo.setPosition(servo0, 90));
+  CHECK(ISR_Servo.getPulseWidth(servo0) == 1470);
+
+  // Nothing reported before the frame
+  CHECK(ISR_Servo.schedulePosition(servo0, 180, ISR_Servo.getReferenceFrame() + 100));
+  runFrames(ISR_Servo, 50);
+  CHECK(ISR_Servo.getPosition(servo0) == 90);
+  ISR_Servo.snapshot(snap);
+  CHECK( (snap.position[slot0] == 90) && (snap.pulseWidth[slot0] == 1470) );
+
+  // Applied at the frame, position included
+  runFrames(ISR_Servo, 51);
+  CHECK(ISR_Servo.getPosition(servo0) == 180);
+  CHECK(ISR_Servo.getPulseWidth(servo0) == 2400);
+  ISR_Servo.snapshot(snap);
+  CHECK( (snap.position[slot0] == 180) && (snap.pulseWidth[slot0] == 2400) );
+
+  // Then the reference for change detection : back to 90 is applied
+  CHECK(ISR_Servo.setPosition(servo0, 90));
+  CHECK(ISR_Servo.getPulseWidth(servo0) == 1470);
+
+  // An immediate update to the scheduled position is applied at once, and cancels the scheduled move
+  CHECK(ISR_Servo.schedulePosition(servo0, 180, ISR_Servo.getReferenceFrame() + 100));
+  CHECK(ISR_Servo.setPosition(servo0, 180));
+  CHECK(ISR_Servo.getPulseWidth(servo0) == 2400);
+
+  // Even to the current position
+  CHECK(ISR_Servo.schedulePosition(servo0, 0, ISR_Servo.getReferenceFrame() + 10));
+  CHECK(ISR_Servo.setPosition(servo0, 180));
+  runFrames(ISR_Servo, 20);
+  CHECK(ISR_Servo.getPosition(servo0) == 180);
+  CHECK(ISR_Servo.getPulseWidth(servo0) == 2400);
+
+  // A group update cancels it too
+  ESP8266_ISR_Servo_Group group;
+  uint16_t                pulseWidths[2] = { 1000, 2000 };
+
+  group.add(servo0);
+  group.add(servo1);
+
+  pulseWidth = 1500;
+  CHECK(ISR_Servo.schedulePulseWidth(servo1, pulseWidth, ISR_Servo.getReferenceFrame() + 10));
+  CHECK(ISR_Servo.setPulseWidths(group, pulseWidths));
+  runFrames(ISR_Servo, 20);
+  CHECK(ISR_Servo.getPulseWidth(servo0) == 1000);
+  CHECK(ISR_Servo.getPulseWidth(servo1) == 2000);
+
+  return testResult("test_schedule");
+}
@@ -0,0 +1,129 @@
+// Frame sync of 2 controllers with skewed clocks to a shared reference time, on simulated time
+// The reference time crosses 2^32 microsecs, where a 32-bit time base would wrap
+
+#include "ESP8266_ISR_Servo.h"
+#include "test_harness.h"
+
+#define TICK_NS           (TIMER_INTERVAL_MICRO * 1000ULL)
+
+// Controller with its own clock, 'ppm' fast, started 'startNs' after the reference time base
+typedef struct
+{
+  ESP8266_ISR_Servo*  controller;
+  double              tickNs;
+  double              nextTickNs;
+  uint32_t            lastFrameCount;
+  uint64_t            frameStartNs;             // reference time of the last frame start
+  uint32_t            frameStartRefFrame;       // its reference frame
+} sim_controller_t;
+
+static ESP8266_ISR_Servo  controllerA, controllerB;
+static sim_controller_t   sim[2];
+
+static void initSim(sim_controller_t& s, ESP8266_ISR_Servo& controller, const double& ppm, const double& startNs)
+{
+  s.controller      = &controller;
+  s.tickNs          = TICK_NS / (1 + ppm / 1e6);
+  s.nextTickNs      = startNs;
+  s.lastFrameCount  = 0;
+  s.frameStartNs    = 0;
+}
+
+// Run both controllers until nowNs, recording their frame starts
+static void runUntil(const double& nowNs)
+{
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    while (sim[i].nextTickNs < nowNs)
+    {
+      sim[i].controller->run();
+
+      if (sim[i].controller->getFrameCount() != sim[i].lastFrameCount)
+      {
+        sim[i].lastFrameCount     = sim[i].controller->getFrameCount();
+        sim[i].frameStartNs       = (uint64_t) sim[i].nextTickNs;
+        sim[i].frameStartRefFrame = sim[i].controller->getReferenceFrame();
+      }
+
+      sim[i].nextTickNs += sim[i].tickNs;
+    }
+  }
+}
+
+int main()
+{
+  // Reference time at the start : 20s before the 32-bit wrap
+  const uint64_t  baseMicros  = (1ULL << 32) - 20000000ULL;
+  const uint32_t  seconds     = 60;
+
+  int8_t servoA = controllerA.setupServo(D1);
+  int8_t servoB = controllerB.setupServo(D2);
+
+  // A 50 ppm fast, B 50 ppm slow and 7ms late
+  initSim(sim[0], controllerA, 50, 0);
+  initSim(sim[1], controllerB, -50, 7000000);
+
+  int64_t   maxGridError = 0;
+  int32_t   maxSkew = 0;
+  uint32_t  refFrameMismatches = 0;
+
+  for (uint32_t second = 1; second <= seconds; second++)
+  {
+    double nowNs = second * 1e9;
+
+    runUntil(nowNs);
+
+    // Sync packet, with the reference time extended to 64 bits
+    uint64_t refTime = baseMicros + (uint64_t) (nowNs / 1000);
+
+    controllerA.syncToReference(refTime);
+    controllerB.syncToReference(refTime);
+
+    // Converged after 15s : 7ms at 10us per frame
+    if (second > 20)
+    {
+      // Frame starts on the reference grid : reference frame N starts at N * REFRESH_INTERVAL
+      for (uint8_t i = 0; i < 2; i++)
+      {
+        int64_t gridError = (int64_t) (baseMicros + sim[i].frameStartNs / 1000)
+                            - (int64_t) sim[i].frameStartRefFrame * REFRESH_INTERVAL;
+
+        // Reference frame numbers modulo 2^32 frames, far away here
+        maxGridError = std::max(maxGridError, (int64_t) std::llabs(gridError));
+      }
+
+      if (sim[0].frameStartRefFrame != sim[1].frameStartRefFrame)
+        refFrameMismatches++;
+
+      maxSkew = std::max(maxSkew, (int32_t) std::abs( (int64_t) sim[0].frameStartNs - (int64_t) sim[1].frameStartNs) / 1000);
+    }
+  }
+
+  // Drift between 2 syncs : 50ppm of 1s, plus one tick
+  CHECK(maxGridError <= 50 + TIMER_INTERVAL_MICRO);
+  CHECK(maxSkew <= 2 * (50 + TIMER_INTERVAL_MICRO));
+  CHECK(refFrameMismatches == 0);
+
+  // The reference time crossed 2^32 microsecs without any jump of the frame grid
+  CHECK(baseMicros + seconds * 1000000ULL > (1ULL << 32));
+
+  // A move scheduled for the same reference frame starts in the same frame on both boards
+  uint32_t atFrame = controllerA.getReferenceFrame() + 10;
+
+  controllerA.schedulePosition(servoA, 180, atFrame);
+  controllerB.schedulePosition(servoB, 180, atFrame);
+
+  double nowNs = seconds * 1e9;
+
+  while ( (controllerA.getPulseWidth(servoA) != 2400) || (controllerB.getPulseWidth(servoB) != 2400) )
+  {
+    nowNs += TICK_NS;
+    runUntil(nowNs);
+  }
+
+  CHECK(sim[0].frameStartRefFrame == atFrame);
+  CHECK(sim[1].frameStartRefFrame == atFrame);
+  CHECK(std::abs( (int64_t) sim[0].frameStartNs - (int64_t) sim[1].frameStartNs) / 1000 <= 2 * (50 + TIMER_INTERVAL_MICRO));
+
+  return testResult("test_sync");
+}
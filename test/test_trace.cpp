@@ -0,0 +1,96 @@
+// Edge trace capture, VCD export and pulse statistics, on simulated time
+// The VCD of the first capture is written to $(BUILD)/trace.vcd, to be compared across changes
+
+#include "ESP8266_ISR_Servo.h"
+#include "test_harness.h"
+
+static uint16_t countLines(const std::string& text, const char& first)
+{
+  uint16_t  lines = 0;
+  size_t    pos = 0;
+
+  while (pos < text.size())
+  {
+    if (text[pos] == first)
+      lines++;
+
+    pos = text.find('\n', pos);
+
+    if (pos == std::string::npos)
+      break;
+
+    pos++;
+  }
+
+  return lines;
+}
+
+int main()
+{
+  int8_t    servo0 = ISR_Servo.setupServo(D1);
+  int8_t    servo1 = ISR_Servo.setupServo(D2);
+  uint16_t  pulseWidth;
+
+  pulseWidth = 1000;
+  ISR_Servo.setPulseWidth(servo0, pulseWidth);
+  pulseWidth = 1500;
+  ISR_Servo.setPulseWidth(servo1, pulseWidth);
+  runFrames(ISR_Servo, 1);
+
+  // Edges only : 4 events per frame, far from filling the buffer
+  ISR_Servo.startTrace();
+  runFrames(ISR_Servo, 3);
+  CHECK(!ISR_Servo.isTraceDone());
+
+  ISR_Servo.stopTrace();
+  CHECK(ISR_Servo.isTraceDone());
+
+  StringPrint vcd;
+
+  ISR_Servo.dumpTraceVCD(vcd);
+  CHECK(vcd.text.find("$var wire 1 ! servo0 $end") != std::string::npos);
+  CHECK(vcd.text.find("$var wire 1 \" servo1 $end") != std::string::npos);
+  CHECK(countLines(vcd.text, '#') == 1 + 3 * 4);
+
+  FILE* file = fopen(TEST_BUILD_DIR "/trace.vcd", "w");
+
+  if (file)
+  {
+    fputs(vcd.text.c_str(), file);
+    fclose(file);
+  }
+
+  // The falling edge is output at timerCount == count, one tick after the rising edge at timerCount == 1
+  StringPrint stats;
+
+  ISR_Servo.printTraceStats(stats);
+  CHECK(stats.text.find("Slot 0: width avg = 990.00, min = 990.00, max = 990.00, period avg = 20000.00, jitter = 0.00")
+        != std::string::npos);
+  CHECK(stats.text.find("Slot 1: width avg = 1490.00") != std::string::npos);
+
+  // Every run() recorded : the buffer is full before the end of the frame, no period
+  ISR_Servo.startTrace(true);
+  runFrames(ISR_Servo, 1);
+  CHECK(ISR_Servo.isTraceDone());
+
+  stats.text.clear();
+  ISR_Servo.printTraceStats(stats);
+  CHECK(stats.text.find("period") == std::string::npos);
+
+  // Short runs without edge dropped : 3 runs with edges per frame, each with entry / exit, plus 4 edges
+  ISR_Servo.startTrace(true, 1);
+  runFrames(ISR_Servo, 10);
+  CHECK(!ISR_Servo.isTraceDone());
+  ISR_Servo.stopTrace();
+
+  vcd.text.clear();
+  ISR_Servo.dumpTraceVCD(vcd);
+  CHECK(countLines(vcd.text, '#') == 1 + 10 * (3 * 2 + 4));
+
+  stats.text.clear();
+  ISR_Servo.printTraceStats(stats);
+  CHECK(stats.text.find("Slot 0: width avg = 990.00, min = 990.00, max = 990.00, period avg = 20000.00, jitter = 0.00")
+        != std::string::npos);
+
+  return testResult("test_trace");
+}
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+#
+# Encode a CSV motion into a motion file for ESP8266_ISR_Servo_Motion (see src/ESP8266_ISR_Servo_Motion.h)
+#
+# One CSV line per frame (REFRESH_INTERVAL = 20ms), one column per channel, pulse widths in microsecs.
+# An empty cell keeps the previous pulse width of the channel. Lines starting with '#' are ignored.
+#
+# Usage: motion_encoder.py motion.csv motion.ism
+
+import csv
+import struct
+import sys
+
+REFRESH_INTERVAL = 20000
+MAX_CHANNELS = 16
+ABSOLUTE = -128
+
+
+def encode(rows):
+    num_channels = max(len(row) for row in rows)
+
+    if num_channels == 0 or num_channels > MAX_CHANNELS:
+        raise ValueError("1 to %d channels expected, got %d" % (MAX_CHANNELS, num_channels))
+
+    frames = bytearray()
+    previous = [0] * num_channels
+
+    for row in rows:
+        mask = 0
+        data = bytearray()
+
+        for channel in range(num_channels):
+            cell = row[channel].strip() if channel < len(row) else ""
+
+            if cell == "":
+                continue
+
+            pulse_width = int(cell)
+
+            if pulse_width < 0 or pulse_width > 0xFFFF:
+                raise ValueError("Bad pulse width %d" % pulse_width)
+
+            if pulse_width == previous[channel]:
+                continue
+
+            delta = pulse_width - previous[channel]
+            mask |= 1 << channel
+
+            # The first pulse width of a channel is always absolute, as previous is 0
+            if -127 <= delta <= 127:
+                data += struct.pack("<b", delta)
+            else:
+                data += struct.pack("<bH", ABSOLUTE, pulse_width)
+
+            previous[channel] = pulse_width
+
+        frames += struct.pack("<H", mask) + data
+
+    header = b"ISM1" + struct.pack("<BBHI", num_channels, 0, REFRESH_INTERVAL, len(rows))
+
+    return header + frames
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("Usage: %s motion.csv motion.ism" % sys.argv[0])
+
+    with open(sys.argv[1], newline="") as csv_file:
+        rows = [row for row in csv.reader(csv_file) if row and not row[0].startswith("#")]
+
+    data = encode(rows)
+
+    with open(sys.argv[2], "wb") as motion_file:
+        motion_file.write(data)
+
+    print("%d frames, %d bytes" % (len(rows), len(data)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,55 @@
+#!/bin/bash
+#
+# Report the IRAM / DRAM / flash bytes used by the library, for each build configuration
+# Builds examples/ESP8266_ISR_MultiServos with arduino-cli, then sums the sizes of the library symbols in the ELF
+#
+# Usage: utils/size_report.sh [fqbn]
+# Needs arduino-cli with the esp8266 core. Set NM to the xtensa-lx106-elf-nm path if it is not found
+
+FQBN=${1:-esp8266:esp8266:nodemcuv2}
+SKETCH=examples/ESP8266_ISR_MultiServos
+BUILD_DIR=${BUILD_DIR:-/tmp/ESP8266_ISR_Servo_size}
+
+if [ -z "$NM" ]; then
+  NM=$(ls ~/.arduino15/packages/esp8266/tools/xtensa-lx106-elf-gcc/*/bin/xtensa-lx106-elf-nm 2>/dev/null | tail -n 1)
+fi
+
+if [ -z "$NM" ]; then
+  echo "xtensa-lx106-elf-nm not found, set NM"
+  exit 1
+fi
+
+CONFIGS=(
+  "default|"
+  "minimal|-DISR_SERVO_MINIMAL_FOOTPRINT=1"
+  "minimal_8_servos|-DISR_SERVO_MINIMAL_FOOTPRINT=1 -DISR_SERVO_MAX_SERVOS=8"
+  "trace|-DISR_SERVO_TRACE=1"
+)
+
+printf "%-20s %10s %10s %10s\n" "Configuration" "IRAM" "DRAM" "Flash"
+
+for config in "${CONFIGS[@]}"; do
+  name=${config%%|*}
+  flags=${config#*|}
+
+  if ! arduino-cli compile --fqbn "$FQBN" --library . --build-path "$BUILD_DIR/$name" \
+       --build-property "compiler.cpp.extra_flags=$flags" "$SKETCH" > "$BUILD_DIR.$name.log" 2>&1; then
+    echo "$name: build failed, see $BUILD_DIR.$name.log"
+    continue
+  fi
+
+  # Library symbols only. IRAM at 0x40100000, flash (irom) from 0x40200000, DRAM (data, rodata, bss) at 0x3FFE8000
+  "$NM" -S -C -t d "$BUILD_DIR/$name"/*.elf | \
+    grep -E "ISR_Servo|ESP8266TimerInterrupt|ISR_SERVO" | \
+    awk -v name="$name" '
+      NF >= 4 {
+        addr = $1 + 0; size = $2 + 0;
+        if (addr >= 1074790400 && addr < 1075838976)
+          iram += size;
+        else if (addr >= 1075838976)
+          flash += size;
+        else if (addr >= 1073643520)
+          dram += size;
+      }
+      END { printf "%-20s %10d %10d %10d\n", name, iram, dram, flash }'
+done